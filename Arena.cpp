@@ -0,0 +1,151 @@
+//====================================================================
+// Arena.cpp
+//
+// This class represents an arena (slab) allocator. Memory is handed
+// out by bumping a pointer through large slabs, and is only given
+// back all at once, so building a structure of many small nodes
+// costs a few large allocations and tearing it down costs one call.
+// It is used by Graph.h for its EdgeNodes.
+//====================================================================
+// Arena class:
+//   Includes following features:
+// 	- allows allocating memory for an object.
+//	- allows making room for many allocations in one slab.
+//	- allows releasing every allocation at once.
+//	- allows swapping the slabs of two arenas.
+//	- allows knowing the number of slabs and bytes handed out.
+// Assumptions:
+// 	- nothing allocated needs more than ALIGNMENT byte alignment.
+//	- destructors of objects in the arena are not run, so they
+//	  have to be trivial or not matter.
+//====================================================================
+
+#include "Arena.h"
+#include <algorithm> // swap
+
+
+//========================Default-Constructor=========================
+// Creates an Arena that holds no slabs.
+//
+// Preconditions: None.
+//
+// Postconditions: Nothing has been allocated.
+//====================================================================
+Arena::Arena () : my_next (NULL), my_end (NULL), 
+		  my_slab_size (FIRST_SLAB), my_used (0)
+{
+}
+
+
+//========================Destructor==================================
+// Releases every slab.
+//====================================================================
+Arena::~Arena ()
+{
+	release();
+}
+
+
+//========================allocate====================================
+// Returns memory for the given number of bytes, aligned to ALIGNMENT.
+// Slabs come from new[], which aligns them for any type, and every
+// allocation is rounded up to a multiple of ALIGNMENT, so the next
+// one is aligned too.
+//
+// Preconditions: None.
+//
+// Postconditions: The memory stays valid until release.
+//====================================================================
+void *Arena::allocate (size_t the_bytes)
+{
+	char *memory;
+
+	the_bytes = (the_bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	if ((size_t) (my_end - my_next) < the_bytes)
+		reserve (the_bytes);
+
+	memory   = my_next;
+	my_next += the_bytes;
+	my_used += the_bytes;
+	return memory;
+}
+
+
+//========================reserve=====================================
+// Makes sure the given number of bytes can be allocated from the
+// current slab. If not, a new slab is started that is big enough,
+// and the rest of the current one is left unused.
+//
+// Preconditions: None.
+//
+// Postconditions: Allocations adding up to the given number of bytes
+//		   (after rounding) need no new slab.
+//====================================================================
+void Arena::reserve (size_t the_bytes)
+{
+	size_t size;
+
+	if ((size_t) (my_end - my_next) >= the_bytes) return;
+
+	size = (the_bytes > my_slab_size) ? the_bytes : my_slab_size;
+	my_slabs.push_back (new char [size]);
+	my_next = my_slabs.back();
+	my_end  = my_next + size;
+
+	if (my_slab_size < MAX_SLAB)
+		my_slab_size *= 2;
+}
+
+
+//========================release=====================================
+// Gives back every slab, and with them every allocation.
+//
+// Preconditions: Nothing allocated is still in use.
+//
+// Postconditions: Nothing has been allocated.
+//====================================================================
+void Arena::release ()
+{
+	int i;
+
+	for (i = 0; i < (int) my_slabs.size(); i++)
+		delete [] my_slabs [i];
+	my_slabs.clear();
+	my_next      = NULL;
+	my_end       = NULL;
+	my_slab_size = FIRST_SLAB;
+	my_used      = 0;
+}
+
+
+//========================swap========================================
+// Exchanges the slabs of this arena and the given one. The slabs do
+// not move, so every allocation stays valid.
+//====================================================================
+void Arena::swap (Arena &the_other)
+{
+	my_slabs.swap (the_other.my_slabs);
+	std::swap (my_next, the_other.my_next);
+	std::swap (my_end, the_other.my_end);
+	std::swap (my_slab_size, the_other.my_slab_size);
+	std::swap (my_used, the_other.my_used);
+}
+
+
+//========================getSlabCount================================
+// Returns the number of slabs allocated since the last release.
+//====================================================================
+int Arena::getSlabCount () const
+{
+	return (int) my_slabs.size();
+}
+
+
+//========================getBytesUsed================================
+// Returns the number of bytes handed out since the last release,
+// after rounding.
+//====================================================================
+size_t Arena::getBytesUsed () const
+{
+	return my_used;
+}
@@ -0,0 +1,131 @@
+//====================================================================
+// Arena.h
+//
+// This class represents an arena (slab) allocator. Memory is handed
+// out by bumping a pointer through large slabs, and is only given
+// back all at once, so building a structure of many small nodes
+// costs a few large allocations and tearing it down costs one call.
+// It is used by Graph.h for its EdgeNodes.
+//====================================================================
+// Arena class:
+//   Includes following features:
+// 	- allows allocating memory for an object.
+//	- allows making room for many allocations in one slab.
+//	- allows releasing every allocation at once.
+//	- allows swapping the slabs of two arenas.
+//	- allows knowing the number of slabs and bytes handed out.
+// Assumptions:
+// 	- nothing allocated needs more than ALIGNMENT byte alignment.
+//	- destructors of objects in the arena are not run, so they
+//	  have to be trivial or not matter.
+//====================================================================
+
+#ifndef _ARENA_H
+#define _ARENA_H
+#include <stddef.h> // size_t
+#include <vector>
+using namespace std;
+
+class Arena {
+
+public:
+
+	//========================Default-Constructor=================
+	// Creates an Arena that holds no slabs.
+	//
+	// Preconditions: None.
+	//
+	// Postconditions: Nothing has been allocated.
+	//============================================================
+	Arena ();
+
+
+	//========================Destructor==========================
+	// Releases every slab.
+	//============================================================
+	~Arena ();
+
+
+	//========================allocate============================
+	// Returns memory for the given number of bytes, aligned to
+	// ALIGNMENT. Starts a new slab if the current one is full.
+	//
+	// Preconditions: None.
+	//
+	// Postconditions: The memory stays valid until release.
+	//============================================================
+	void *allocate (size_t);
+
+
+	//========================reserve=============================
+	// Makes sure the given number of bytes can be allocated from
+	// the current slab, starting a big enough new one if not.
+	//
+	// Preconditions: None.
+	//
+	// Postconditions: Allocations adding up to the given number
+	//		   of bytes (after rounding) need no new slab.
+	//============================================================
+	void reserve (size_t);
+
+
+	//========================release=============================
+	// Gives back every slab, and with them every allocation.
+	//
+	// Preconditions: Nothing allocated is still in use.
+	//
+	// Postconditions: Nothing has been allocated.
+	//============================================================
+	void release ();
+
+
+	//========================swap================================
+	// Exchanges the slabs of this arena and the given one. The
+	// slabs do not move, so every allocation stays valid.
+	//============================================================
+	void swap (Arena &);
+
+
+	//========================getSlabCount========================
+	// Returns the number of slabs allocated since the last
+	// release.
+	//============================================================
+	int getSlabCount () const;
+
+
+	//========================getBytesUsed========================
+	// Returns the number of bytes handed out since the last
+	// release, after rounding.
+	//============================================================
+	size_t getBytesUsed () const;
+
+private:
+
+	// Copying would give back the same slabs twice.
+	Arena (const Arena &);
+	Arena &operator= (const Arena &);
+
+
+	// Every allocation is rounded up to a multiple of this.
+	static const size_t ALIGNMENT = 8;
+
+	// The size of the first slab. Each new slab is twice the
+	// size of the last, up to MAX_SLAB.
+	static const size_t FIRST_SLAB = 1 << 16;
+	static const size_t MAX_SLAB = 1 << 24;
+
+
+	// The slabs allocated since the last release.
+	vector<char *> my_slabs;
+
+	// The free part of the current slab.
+	char *my_next;
+	char *my_end;
+
+	// The size of the next slab.
+	size_t my_slab_size;
+
+	// The bytes handed out since the last release.
+	size_t my_used;
+};
+#endif /* _ARENA_H */
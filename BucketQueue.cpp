@@ -0,0 +1,138 @@
+//====================================================================
+// BucketQueue.cpp
+//
+// This class represents Dial's bucket queue of vertices keyed by
+// their tentative distance. It is used by Graph.h as the priority
+// queue of Dijkstra's algorithm when every edge weight is a small
+// int. Dijkstra's algorithm only pushes keys between the last key
+// popped and that plus the largest weight, so max weight + 1 buckets
+// used round robin hold every key, and finding the next one only
+// walks forward over empty buckets. It is a template on the type of
+// the keys, and BucketQueue is the one with int keys.
+//====================================================================
+// BucketQueue class:
+//   Includes following features:
+// 	- allows setting the largest edge weight.
+//	- allows pushing a vertex with a key.
+//	- allows popping a vertex with the smallest key.
+// Assumptions:
+// 	- keys are pushed in the range above, which holds for
+//	  Dijkstra's algorithm with weights from 0 to the largest.
+//	- the keys are int or long long, the types BucketQueue.cpp
+//	  instantiates it for.
+//	- a vertex whose key drops is pushed again, and the caller
+//	  skips the stale copy when it is popped.
+//====================================================================
+
+#include "BucketQueue.h"
+
+
+//========================Default-Constructor=========================
+// Creates an empty BucketQueue for weights up to 0.
+//
+// Preconditions: None.
+//
+// Postconditions: The queue is empty.
+//====================================================================
+template <class K>
+BasicBucketQueue<K>::BasicBucketQueue () : my_key (0), my_index (0), my_count (0)
+{
+	reset (0);
+}
+
+
+//========================reset=======================================
+// Empties the queue and makes room for keys up to the given largest
+// edge weight past the smallest one. The buckets keep their memory,
+// so resetting between sources allocates nothing.
+//
+// Preconditions: The weight is not negative.
+//
+// Postconditions: The queue is empty and its next key is 0.
+//====================================================================
+template <class K>
+void BasicBucketQueue<K>::reset (int the_max_weight)
+{
+	int i;
+
+	// A run pops everything it pushes, so usually nothing is left.
+	if (my_count > 0) {
+		for (i = 0; i < (int) my_buckets.size(); i++)
+			my_buckets [i].clear();
+	}
+	// In size_t, so INT_MAX + 1 does not overflow.
+	if (my_buckets.size() != (size_t) the_max_weight + 1)
+		my_buckets.resize ((size_t) the_max_weight + 1);
+	my_key   = 0;
+	my_index = 0;
+	my_count = 0;
+}
+
+
+//========================isEmpty=====================================
+// Returns true if the queue holds no vertices.
+//====================================================================
+template <class K>
+bool BasicBucketQueue<K>::isEmpty () const
+{
+	return my_count == 0;
+}
+
+
+//========================push========================================
+// Inserts the int (a vertex) with the given key.
+//
+// Preconditions: The key is at least the key of the last vertex
+//		  popped, and at most that plus the largest weight.
+//
+// Postconditions: The vertex is in the queue.
+//====================================================================
+template <class K>
+void BasicBucketQueue<K>::push (int the_vertex, K the_key)
+{
+	int index = my_index + (int) (the_key - my_key);
+
+	if (index >= (int) my_buckets.size()) index -= (int) my_buckets.size();
+	my_buckets [index].push_back (the_vertex);
+	my_count++;
+}
+
+
+//========================pop=========================================
+// Removes and returns a vertex with the smallest key. The buckets
+// are walked forward from the current one, one key at a time.
+//
+// Preconditions: The queue is not empty.
+//
+// Postconditions: getKey returns the key it had.
+//====================================================================
+template <class K>
+int BasicBucketQueue<K>::pop ()
+{
+	int vertex;
+
+	while (my_buckets [my_index].empty()) {
+		my_key++;
+		my_index++;
+		if (my_index == (int) my_buckets.size()) my_index = 0;
+	}
+	vertex = my_buckets [my_index].back();
+	my_buckets [my_index].pop_back();
+	my_count--;
+	return vertex;
+}
+
+
+//========================getKey======================================
+// Returns the key of the last vertex popped.
+//====================================================================
+template <class K>
+K BasicBucketQueue<K>::getKey () const
+{
+	return my_key;
+}
+
+
+// The key types of the graphs Graph.cpp instantiates.
+template class BasicBucketQueue<int>;
+template class BasicBucketQueue<long long>;
@@ -0,0 +1,110 @@
+//====================================================================
+// BucketQueue.h
+//
+// This class represents Dial's bucket queue of vertices keyed by
+// their tentative distance. It is used by Graph.h as the priority
+// queue of Dijkstra's algorithm when every edge weight is a small
+// int. Dijkstra's algorithm only pushes keys between the last key
+// popped and that plus the largest weight, so max weight + 1 buckets
+// used round robin hold every key, and finding the next one only
+// walks forward over empty buckets. It is a template on the type of
+// the keys, and BucketQueue is the one with int keys.
+//====================================================================
+// BucketQueue class:
+//   Includes following features:
+// 	- allows setting the largest edge weight.
+//	- allows pushing a vertex with a key.
+//	- allows popping a vertex with the smallest key.
+// Assumptions:
+// 	- keys are pushed in the range above, which holds for
+//	  Dijkstra's algorithm with weights from 0 to the largest.
+//	- the keys are int or long long, the types BucketQueue.cpp
+//	  instantiates it for.
+//	- a vertex whose key drops is pushed again, and the caller
+//	  skips the stale copy when it is popped.
+//====================================================================
+
+#ifndef _BUCKETQUEUE_H
+#define _BUCKETQUEUE_H
+#include <vector>
+using namespace std;
+
+template <class K>
+class BasicBucketQueue {
+
+public:
+
+	//========================Default-Constructor=================
+	// Creates an empty BucketQueue for weights up to 0.
+	//
+	// Preconditions: None.
+	//
+	// Postconditions: The queue is empty.
+	//============================================================
+	BasicBucketQueue ();
+
+
+	//========================reset===============================
+	// Empties the queue and makes room for keys up to the given
+	// largest edge weight past the smallest one.
+	//
+	// Preconditions: The weight is not negative.
+	//
+	// Postconditions: The queue is empty and its next key is 0.
+	//============================================================
+	void reset (int);
+
+
+	//========================isEmpty=============================
+	// Returns true if the queue holds no vertices.
+	//============================================================
+	bool isEmpty () const;
+
+
+	//========================push================================
+	// Inserts the int (a vertex) with the given key.
+	//
+	// Preconditions: The key is at least the key of the last
+	//		  vertex popped, and at most that plus the largest
+	//		  weight.
+	//
+	// Postconditions: The vertex is in the queue.
+	//============================================================
+	void push (int, K);
+
+
+	//========================pop=================================
+	// Removes and returns a vertex with the smallest key.
+	//
+	// Preconditions: The queue is not empty.
+	//
+	// Postconditions: getKey returns the key it had.
+	//============================================================
+	int pop ();
+
+
+	//========================getKey==============================
+	// Returns the key of the last vertex popped.
+	//============================================================
+	K getKey () const;
+
+private:
+
+	// The buckets, used round robin: the vertices with key k are
+	// in bucket k % my_buckets.size().
+	vector< vector<int> > my_buckets;
+
+	// The key of the bucket being emptied, the smallest key in
+	// the queue.
+	K my_key;
+
+	// The index of that bucket.
+	int my_index;
+
+	// The number of vertices in the queue.
+	int my_count;
+};
+
+// The bucket queue used with int distances.
+typedef BasicBucketQueue<int> BucketQueue;
+#endif /* _BUCKETQUEUE_H */
@@ -0,0 +1,317 @@
+//====================================================================
+// ConcurrentGraph.cpp
+//
+// This class represents a Graph shared between one writer and many
+// reader threads. The writer changes a private Graph and publishes
+// a read-only snapshot of it as a new version with one atomic store.
+// Readers never lock: each one copies the current version into a
+// snapshot of its own (which only shares the CSR arrays) and answers
+// queries from that. A version the writer replaces is deleted once
+// no reader can still be looking at it, which is tracked with
+// epochs: a reader announces the epoch it started in while it picks
+// up the version, and a version retired in an epoch is only deleted
+// after every reader has announced a later one or gone idle.
+//====================================================================
+// ConcurrentGraph class:
+//   Includes following features:
+// 	- allows building the graph from a data file.
+//	- allows inserting and removing edges, which readers see once
+//	  they are published.
+//	- allows publishing the changes as a new version.
+//	- allows reading from many threads at once with a Reader each,
+//	  without locking, while the writer keeps working.
+// Assumptions:
+// 	- each Reader is used by one thread at a time.
+//	- no more than MAX_READERS Readers exist at once.
+//	- every Reader is destroyed before the ConcurrentGraph.
+//====================================================================
+
+#include "ConcurrentGraph.h"
+
+
+//========================Default-Constructor=========================
+// Creates a ConcurrentGraph holding an empty graph, published as
+// version 1.
+//
+// Preconditions: None.
+//
+// Postconditions: The graph has no vertices.
+//====================================================================
+ConcurrentGraph::ConcurrentGraph () : my_current (NULL), my_version (0),
+				      my_epoch (1)
+{
+	int slot;
+
+	for (slot = 0; slot < MAX_READERS; slot++) {
+		my_claimed [slot].store (false);
+		my_announced [slot].store (0);
+	}
+
+	// Readers answer from snapshots, which search a single path
+	// at a time instead of filling the table.
+	my_graph.setLazy (true);
+
+	lock_guard<mutex> guard (my_writer_lock);
+	publish_locked();
+}
+
+
+//========================Destructor==================================
+// Deletes every version.
+//
+// Preconditions: Every Reader has been destroyed.
+//====================================================================
+ConcurrentGraph::~ConcurrentGraph ()
+{
+	int i;
+
+	for (i = 0; i < (int) my_retired.size(); i++)
+		delete my_retired [i].version;
+	delete my_current.load();
+}
+
+
+//========================buildGraph==================================
+// Builds the writer's graph from the given file, the way
+// Graph::buildGraph does, and publishes it.
+//
+// Preconditions: The file is open.
+//
+// Postconditions: Returns false if the file is malformed, in which
+//		   case nothing is published.
+//====================================================================
+bool ConcurrentGraph::buildGraph (ifstream &the_infile)
+{
+	lock_guard<mutex> guard (my_writer_lock);
+
+	if (!my_graph.buildGraph (the_infile)) return false;
+	publish_locked();
+	return true;
+}
+
+
+//========================insertEdge==================================
+// Inserts an edge into the writer's graph, the way Graph::insertEdge
+// does. Readers see it once it is published.
+//====================================================================
+bool ConcurrentGraph::insertEdge (int the_from_v, int the_to_v,
+				  int the_weight)
+{
+	lock_guard<mutex> guard (my_writer_lock);
+	return my_graph.insertEdge (the_from_v, the_to_v, the_weight);
+}
+
+
+//========================removeEdge==================================
+// Removes an edge from the writer's graph, the way Graph::removeEdge
+// does. Readers see it once it is published.
+//====================================================================
+bool ConcurrentGraph::removeEdge (int the_from_v, int the_to_v)
+{
+	lock_guard<mutex> guard (my_writer_lock);
+	return my_graph.removeEdge (the_from_v, the_to_v);
+}
+
+
+//========================publish=====================================
+// Makes the writer's graph as it is now the version readers see, and
+// deletes old versions no reader can still see.
+//
+// Preconditions: None.
+//
+// Postconditions: Returns the number of the new version.
+//====================================================================
+int ConcurrentGraph::publish ()
+{
+	lock_guard<mutex> guard (my_writer_lock);
+	return publish_locked();
+}
+
+
+//========================getVersion==================================
+// Returns the number of the latest published version.
+//====================================================================
+int ConcurrentGraph::getVersion () const
+{
+	return my_version.load();
+}
+
+
+//========================getRetiredCount=============================
+// Returns the number of replaced versions not deleted yet, because a
+// reader may still be looking at them.
+//====================================================================
+int ConcurrentGraph::getRetiredCount ()
+{
+	lock_guard<mutex> guard (my_writer_lock);
+	reclaim();
+	return (int) my_retired.size();
+}
+
+
+//========================publish_locked==============================
+// Publishes the writer's graph. A reader that loaded the old version
+// announced the current epoch or an earlier one before loading it,
+// so the old version is retired in the current epoch, and the epoch
+// advances for readers that will only see the new one.
+//
+// Preconditions: my_writer_lock is held.
+//====================================================================
+int ConcurrentGraph::publish_locked ()
+{
+	Version *version = new Version;
+	Version *old;
+	Retired retired;
+
+	version->graph  = my_graph.snapshot();
+	version->number = my_version.load() + 1;
+
+	old = my_current.exchange (version);
+	my_version.store (version->number);
+
+	if (old) {
+		retired.version = old;
+		retired.epoch   = my_epoch.fetch_add (1);
+		my_retired.push_back (retired);
+	}
+	reclaim();
+	return version->number;
+}
+
+
+//========================reclaim=====================================
+// Deletes the retired versions retired before the earliest epoch a
+// reader has announced. A reader that announces an epoch after the
+// version was replaced can only load a later one.
+//
+// Preconditions: my_writer_lock is held.
+//====================================================================
+void ConcurrentGraph::reclaim ()
+{
+	unsigned long earliest = 0, epoch;
+	int slot, i, kept;
+
+	for (slot = 0; slot < MAX_READERS; slot++) {
+		epoch = my_announced [slot].load();
+		if (epoch != 0 && (earliest == 0 || epoch < earliest))
+			earliest = epoch;
+	}
+
+	kept = 0;
+	for (i = 0; i < (int) my_retired.size(); i++) {
+		if (earliest == 0 || my_retired [i].epoch < earliest)
+			delete my_retired [i].version;
+		else
+			my_retired [kept++] = my_retired [i];
+	}
+	my_retired.resize (kept);
+}
+
+
+//========================Reader::Constructor=========================
+// Creates a Reader of the given ConcurrentGraph and claims one of its
+// reader slots.
+//
+// Preconditions: None.
+//
+// Postconditions: isAttached is false if all MAX_READERS slots were
+//		   taken.
+//====================================================================
+ConcurrentGraph::Reader::Reader (ConcurrentGraph &the_owner)
+	: my_owner (the_owner), my_slot (-1), my_version (0)
+{
+	int slot;
+	bool free;
+
+	for (slot = 0; slot < MAX_READERS && my_slot == -1; slot++) {
+		free = false;
+		if (my_owner.my_claimed [slot].compare_exchange_strong (free, true))
+			my_slot = slot;
+	}
+}
+
+
+//========================Reader::Destructor==========================
+// Gives back the reader slot.
+//====================================================================
+ConcurrentGraph::Reader::~Reader ()
+{
+	if (my_slot != -1) my_owner.my_claimed [my_slot].store (false);
+}
+
+
+//========================Reader::isAttached==========================
+// Returns true if the Reader got a reader slot. A Reader without one
+// finds no paths.
+//====================================================================
+bool ConcurrentGraph::Reader::isAttached () const
+{
+	return my_slot != -1;
+}
+
+
+//========================Reader::findPath============================
+// Returns the length of the shortest path from the first int to the
+// second int in the latest published version, the way
+// Graph::findPath does.
+//
+// Preconditions: None.
+//
+// Postconditions: Returns -1 if there is no path, a vertex does not
+//		   exist, or the Reader is not attached.
+//====================================================================
+int ConcurrentGraph::Reader::findPath (int the_from_v, int the_to_v)
+{
+	if (my_slot == -1) return -1;
+	refresh();
+	return my_graph.findPath (the_from_v, the_to_v);
+}
+
+
+//========================Reader::display=============================
+// Displays the shortest path from the first int to the second int in
+// the latest published version, the way Graph::display does.
+//====================================================================
+void ConcurrentGraph::Reader::display (int the_from_v, int the_to_v)
+{
+	if (my_slot == -1) return;
+	refresh();
+	my_graph.display (the_from_v, the_to_v);
+}
+
+
+//========================Reader::getVersion==========================
+// Returns the number of the version the last query was answered
+// from, 0 before the first query.
+//====================================================================
+int ConcurrentGraph::Reader::getVersion () const
+{
+	return my_version;
+}
+
+
+//========================Reader::refresh=============================
+// Takes a snapshot of the latest published version if it is not the
+// one my_graph already holds. The epoch is announced before the
+// version is loaded and cleared once the snapshot is taken: the
+// snapshot shares the version's CSR arrays and descriptions through
+// shared_ptrs, so it stays valid after the version is deleted.
+//
+// A published version is itself a snapshot, so taking a snapshot of
+// it only reads it, and many readers can do that at once.
+//====================================================================
+void ConcurrentGraph::Reader::refresh ()
+{
+	Version *version;
+
+	// Nothing was published since the last query.
+	if (my_owner.my_version.load() == my_version) return;
+
+	my_owner.my_announced [my_slot].store (my_owner.my_epoch.load());
+	version = my_owner.my_current.load();
+	if (version->number != my_version) {
+		my_graph   = version->graph.snapshot();
+		my_version = version->number;
+	}
+	my_owner.my_announced [my_slot].store (0);
+}
@@ -0,0 +1,267 @@
+//====================================================================
+// ConcurrentGraph.h
+//
+// This class represents a Graph shared between one writer and many
+// reader threads. The writer changes a private Graph and publishes
+// a read-only snapshot of it as a new version with one atomic store.
+// Readers never lock: each one copies the current version into a
+// snapshot of its own (which only shares the CSR arrays) and answers
+// queries from that. A version the writer replaces is deleted once
+// no reader can still be looking at it, which is tracked with
+// epochs: a reader announces the epoch it started in while it picks
+// up the version, and a version retired in an epoch is only deleted
+// after every reader has announced a later one or gone idle.
+//====================================================================
+// ConcurrentGraph class:
+//   Includes following features:
+// 	- allows building the graph from a data file.
+//	- allows inserting and removing edges, which readers see once
+//	  they are published.
+//	- allows publishing the changes as a new version.
+//	- allows reading from many threads at once with a Reader each,
+//	  without locking, while the writer keeps working.
+// Assumptions:
+// 	- each Reader is used by one thread at a time.
+//	- no more than MAX_READERS Readers exist at once.
+//	- every Reader is destroyed before the ConcurrentGraph.
+//====================================================================
+
+#ifndef _CONCURRENTGRAPH_H
+#define _CONCURRENTGRAPH_H
+#include "Graph.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
+using namespace std;
+
+class ConcurrentGraph {
+
+	// One published version of the graph. Never changed once it
+	// is published.
+	struct Version {
+		// A snapshot of the writer's graph.
+		Graph graph;
+		// The number of the version, counting from 1.
+		int number;
+	};
+
+public:
+
+	// The most Readers that can exist at once.
+	static const int MAX_READERS = 64;
+
+
+	// A thread's handle for querying the latest published version.
+	class Reader {
+
+	public:
+
+		//========================Constructor=================
+		// Creates a Reader of the given ConcurrentGraph and
+		// claims one of its reader slots.
+		//
+		// Preconditions: None.
+		//
+		// Postconditions: isAttached is false if all
+		//		   MAX_READERS slots were taken.
+		//====================================================
+		Reader (ConcurrentGraph &);
+
+
+		//========================Destructor==================
+		// Gives back the reader slot.
+		//====================================================
+		~Reader ();
+
+
+		//========================isAttached==================
+		// Returns true if the Reader got a reader slot. A
+		// Reader without one finds no paths.
+		//====================================================
+		bool isAttached () const;
+
+
+		//========================findPath====================
+		// Returns the length of the shortest path from the
+		// first int to the second int in the latest
+		// published version, the way Graph::findPath does.
+		//
+		// Preconditions: None.
+		//
+		// Postconditions: Returns -1 if there is no path, a
+		//		   vertex does not exist, or the Reader
+		//		   is not attached.
+		//====================================================
+		int findPath (int, int);
+
+
+		//========================display=====================
+		// Displays the shortest path from the first int to
+		// the second int in the latest published version,
+		// the way Graph::display does.
+		//====================================================
+		void display (int, int);
+
+
+		//========================getVersion==================
+		// Returns the number of the version the last query
+		// was answered from, 0 before the first query.
+		//====================================================
+		int getVersion () const;
+
+	private:
+
+		//========================refresh=====================
+		// Takes a snapshot of the latest published version
+		// if it is not the one my_graph already holds.
+		//====================================================
+		void refresh ();
+
+
+		// Not copyable, each Reader owns a slot.
+		Reader (const Reader &);
+		Reader &operator= (const Reader &);
+
+
+		// The ConcurrentGraph being read.
+		ConcurrentGraph &my_owner;
+
+		// The index of this Reader's slot, -1 if none.
+		int my_slot;
+
+		// This Reader's snapshot of the version numbered
+		// my_version.
+		Graph my_graph;
+		int my_version;
+	};
+
+
+	//========================Default-Constructor=================
+	// Creates a ConcurrentGraph holding an empty graph, published
+	// as version 1.
+	//
+	// Preconditions: None.
+	//
+	// Postconditions: The graph has no vertices.
+	//============================================================
+	ConcurrentGraph ();
+
+
+	//========================Destructor==========================
+	// Deletes every version.
+	//
+	// Preconditions: Every Reader has been destroyed.
+	//============================================================
+	~ConcurrentGraph ();
+
+
+	//========================buildGraph==========================
+	// Builds the writer's graph from the given file, the way
+	// Graph::buildGraph does, and publishes it.
+	//
+	// Preconditions: The file is open.
+	//
+	// Postconditions: Returns false if the file is malformed, in
+	//		   which case nothing is published.
+	//============================================================
+	bool buildGraph (ifstream &);
+
+
+	//========================insertEdge==========================
+	// Inserts an edge into the writer's graph, the way
+	// Graph::insertEdge does. Readers see it once it is
+	// published.
+	//============================================================
+	bool insertEdge (int, int, int);
+
+
+	//========================removeEdge==========================
+	// Removes an edge from the writer's graph, the way
+	// Graph::removeEdge does. Readers see it once it is
+	// published.
+	//============================================================
+	bool removeEdge (int, int);
+
+
+	//========================publish=============================
+	// Makes the writer's graph as it is now the version readers
+	// see, and deletes old versions no reader can still see.
+	// Each version costs O(V + E) to compile, and every Reader
+	// pays O(V) for its next snapshot and O(V + E) for the
+	// reverse arrays of its first search in it, so changes 
+	// should be published in batches rather than one edge at a
+	// time.
+	//
+	// Preconditions: None.
+	//
+	// Postconditions: Returns the number of the new version.
+	//============================================================
+	int publish ();
+
+
+	//========================getVersion==========================
+	// Returns the number of the latest published version.
+	//============================================================
+	int getVersion () const;
+
+
+	//========================getRetiredCount=====================
+	// Returns the number of replaced versions not deleted yet,
+	// because a reader may still be looking at them.
+	//============================================================
+	int getRetiredCount ();
+
+private:
+
+	// A replaced version, and the epoch it was replaced in.
+	struct Retired {
+		Version *version;
+		unsigned long epoch;
+	};
+
+
+	//========================publish_locked======================
+	// Publishes the writer's graph.
+	//
+	// Preconditions: my_writer_lock is held.
+	//============================================================
+	int publish_locked ();
+
+
+	//========================reclaim=============================
+	// Deletes the retired versions retired before the earliest
+	// epoch a reader has announced.
+	//
+	// Preconditions: my_writer_lock is held.
+	//============================================================
+	void reclaim ();
+
+
+	// Not copyable, readers hold slots in it.
+	ConcurrentGraph (const ConcurrentGraph &);
+	ConcurrentGraph &operator= (const ConcurrentGraph &);
+
+
+	// The latest published version, and its number.
+	atomic<Version *> my_current;
+	atomic<int> my_version;
+
+	// The current epoch, starting at 1. It advances each time a
+	// version is replaced.
+	atomic<unsigned long> my_epoch;
+
+	// Whether each reader slot is taken, and the epoch its reader
+	// announced, 0 while it is not picking up a version.
+	atomic<bool> my_claimed [MAX_READERS];
+	atomic<unsigned long> my_announced [MAX_READERS];
+
+	// Guards everything below.
+	mutex my_writer_lock;
+
+	// The writer's graph.
+	Graph my_graph;
+
+	// The versions replaced but not deleted yet.
+	vector<Retired> my_retired;
+};
+#endif /* _CONCURRENTGRAPH_H */
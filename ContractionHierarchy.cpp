@@ -0,0 +1,694 @@
+//====================================================================
+// ContractionHierarchy.cpp
+//
+// This class represents a contraction hierarchy of a Graph. The
+// vertices are ranked by importance and contracted from the least
+// important up. Contracting a vertex removes it from the graph and
+// adds a shortcut edge between two of its neighbors wherever the
+// shortest path between them went through it. Afterwards every
+// shortest path can be found going only up the ranks from the start
+// and only up the ranks backward from the finish, so a query settles
+// a few hundred vertices instead of the whole graph.
+//====================================================================
+// ContractionHierarchy class:
+//   Includes following features:
+// 	- allows building the hierarchy of a graph.
+//	- allows finding the shortest path between two vertices.
+//	- allows displaying a path the way Graph::display does.
+//	- allows finding the distances from a set of sources to a set
+//	  of targets.
+// Assumptions:
+// 	- the graph is not changed or destroyed after build, otherwise
+//	  build has to be run again.
+//	- edge weights are not negative.
+//====================================================================
+
+#include "ContractionHierarchy.h"
+#include <queue>
+#include <algorithm> // reverse, sort, unique
+
+
+//========================Default-Constructor=========================
+// Creates an empty ContractionHierarchy. No path is found until
+// build is run.
+//
+// Preconditions: None.
+//
+// Postconditions: The hierarchy has no vertices.
+//====================================================================
+ContractionHierarchy::ContractionHierarchy ()
+	: my_graph (NULL), my_size (0), my_shortcuts (0)
+{
+}
+
+
+//========================build=======================================
+// Orders the vertices of the graph, contracts them in that order, and
+// keeps the upward and downward edges, shortcuts included, for
+// queries. The graph is read through its CSR arrays, so a mapped
+// graph can be used as it is.
+//
+// Preconditions: The graph is built.
+//
+// Postconditions: Paths of the graph can be found.
+//====================================================================
+void ContractionHierarchy::build (Graph &the_graph)
+{
+	Arc arc;
+	int vertex, edge, from, to;
+
+	the_graph.compile();
+	my_graph     = &the_graph;
+	my_size      = the_graph.my_size;
+	my_shortcuts = 0;
+
+	// Copy the edges into the lists contraction works on. Not
+	// using index 0. A loop never lies on a shortest path. The
+	// hierarchy uses the numbers from the input, so a reordered
+	// graph's vertices are translated.
+	my_out.assign (my_size + 1, vector<Arc> ());
+	my_in.assign (my_size + 1, vector<Arc> ());
+	for (vertex = 1; vertex <= my_size; vertex++) {
+		from = the_graph.external_id (vertex);
+		for (edge = the_graph.my_out_offsets [vertex];
+		     edge < the_graph.my_out_offsets [vertex + 1]; edge++) {
+			to         = the_graph.external_id (the_graph.my_out_targets [edge]);
+			arc.vertex = to;
+			arc.weight = the_graph.my_out_weights [edge];
+			arc.middle = -1;
+			if (to == from) continue;
+			my_out [from].push_back (arc);
+			arc.vertex = from;
+			my_in [to].push_back (arc);
+		}
+	}
+
+	my_rank.assign (my_size + 1, -1);
+	my_contracted_neighbors.assign (my_size + 1, 0);
+	my_up_lists.assign (my_size + 1, vector<Arc> ());
+	my_down_lists.assign (my_size + 1, vector<Arc> ());
+	order();
+
+	flatten (my_up_lists, my_up_offsets, my_up);
+	flatten (my_down_lists, my_down_offsets, my_down);
+
+	// Only the query arrays are needed from here on.
+	vector< vector<Arc> > ().swap (my_out);
+	vector< vector<Arc> > ().swap (my_in);
+	vector< vector<Arc> > ().swap (my_up_lists);
+	vector< vector<Arc> > ().swap (my_down_lists);
+	vector<int> ().swap (my_contracted_neighbors);
+	my_witness = Search();
+}
+
+
+//========================getShortcutCount============================
+// Returns the number of shortcuts added by build.
+//====================================================================
+int ContractionHierarchy::getShortcutCount () const
+{
+	return my_shortcuts;
+}
+
+
+//========================order=======================================
+// Contracts every vertex, least important first. Contracting a vertex
+// changes the priority of its neighbors, but recomputing them each
+// time costs a witness search per edge and is far too slow where the
+// graph gets dense, so the queue is updated lazily instead: a vertex
+// taken from the queue has its priority recomputed, and goes back in
+// if it is no longer the smallest. Entries left behind by that are
+// skipped because they no longer match current.
+//====================================================================
+void ContractionHierarchy::order ()
+{
+	priority_queue< pair<int, int>, vector< pair<int, int> >,
+			greater< pair<int, int> > > queue;
+	vector<int> current (my_size + 1);
+	vector<int> neighbors;
+	int vertex, value, rank, i;
+
+	for (vertex = 1; vertex <= my_size; vertex++) {
+		current [vertex] = priority (vertex);
+		queue.push (make_pair (current [vertex], vertex));
+	}
+
+	rank = 0;
+	while (!queue.empty()) {
+		value  = queue.top().first;
+		vertex = queue.top().second;
+		queue.pop();
+		if (my_rank [vertex] != -1 || value != current [vertex]) continue;
+
+		// Make sure it is still the least important.
+		value = priority (vertex);
+		if (value > current [vertex] && !queue.empty() &&
+		    value > queue.top().first) {
+			current [vertex] = value;
+			queue.push (make_pair (value, vertex));
+			continue;
+		}
+
+		neighbors.clear();
+		for (i = 0; i < (int) my_out [vertex].size(); i++)
+			neighbors.push_back (my_out [vertex][i].vertex);
+		for (i = 0; i < (int) my_in [vertex].size(); i++)
+			neighbors.push_back (my_in [vertex][i].vertex);
+		sort (neighbors.begin(), neighbors.end());
+		neighbors.erase (unique (neighbors.begin(), neighbors.end()), neighbors.end());
+
+		contract (vertex);
+		my_rank [vertex] = rank++;
+
+		for (i = 0; i < (int) neighbors.size(); i++)
+			my_contracted_neighbors [neighbors [i]]++;
+	}
+}
+
+
+//========================priority====================================
+// Returns how important the given vertex is: the shortcuts
+// contracting it would add, less the edges it would remove, plus the
+// number of its neighbors already contracted. Vertices that add few
+// shortcuts go first, and counting contracted neighbors spreads the
+// contraction evenly over the graph.
+//====================================================================
+int ContractionHierarchy::priority (int the_vertex)
+{
+	return shortcuts (the_vertex, false) - (int) my_out [the_vertex].size() -
+	       (int) my_in [the_vertex].size() +
+	       my_contracted_neighbors [the_vertex];
+}
+
+
+//========================shortcuts===================================
+// Returns the number of shortcuts contracting the given vertex needs.
+// For every edge u -> v into it and v -> w out of it, a shortcut
+// u -> w is needed unless a witness search from u finds a path to w
+// no longer than the two edges without going through v. If the bool
+// is true the shortcuts are added as well.
+//====================================================================
+int ContractionHierarchy::shortcuts (int the_vertex, bool the_add)
+{
+	const vector<Arc> &in  = my_in [the_vertex];
+	const vector<Arc> &out = my_out [the_vertex];
+	int count = 0;
+	int i, j, from, to, via, limit, found;
+
+	for (i = 0; i < (int) in.size(); i++) {
+		from = in [i].vertex;
+
+		// The search only has to go as far as the longest path
+		// through the vertex.
+		limit = -1;
+		for (j = 0; j < (int) out.size(); j++) {
+			if (out [j].vertex != from && in [i].weight + out [j].weight > limit)
+				limit = in [i].weight + out [j].weight;
+		}
+		if (limit == -1) continue;
+		witness_search (from, the_vertex, limit);
+
+		for (j = 0; j < (int) out.size(); j++) {
+			to = out [j].vertex;
+			if (to == from) continue;
+			via   = in [i].weight + out [j].weight;
+			found = my_witness.distance [to];
+			if (found != -1 && found <= via) continue;
+
+			count++;
+			if (the_add) add_shortcut (from, to, via, the_vertex);
+		}
+	}
+	return count;
+}
+
+
+//========================witness_search==============================
+// Runs Dijkstra's algorithm from the first int over the vertices not
+// yet contracted, avoiding the second int. It stops once the next
+// distance is past the third int or WITNESS_LIMIT vertices have been
+// settled. Any distance it leaves is the length of a real path, so
+// it is safe to use even if it is not the shortest.
+//====================================================================
+void ContractionHierarchy::witness_search (int the_source, int the_avoid,
+					   int the_limit)
+{
+	Search &search = my_witness;
+	int settled = 0;
+	int vertex, adjacent, distance, i;
+
+	start_search (search, the_source);
+	while (!search.heap.isEmpty() && search.heap.topKey() <= the_limit &&
+	       settled < WITNESS_LIMIT) {
+		vertex = search.heap.pop();
+		settled++;
+
+		for (i = 0; i < (int) my_out [vertex].size(); i++) {
+			adjacent = my_out [vertex][i].vertex;
+			if (adjacent == the_avoid) continue;
+			distance = search.distance [vertex] + my_out [vertex][i].weight;
+
+			if (search.distance [adjacent] == -1) {
+				search.touched.push_back (adjacent);
+				search.distance [adjacent] = distance;
+				search.heap.push (adjacent, distance);
+			} else if (distance < search.distance [adjacent] &&
+				   search.heap.contains (adjacent)) {
+				search.distance [adjacent] = distance;
+				search.heap.decreaseKey (adjacent, distance);
+			}
+		}
+	}
+}
+
+
+//========================add_shortcut================================
+// Adds the edge from the first int to the second int with the third
+// int as its weight and the fourth int as the vertex it skips. If
+// there already is an edge between them it is replaced, so there is
+// never more than one, and unpack can look edges up by their ends.
+//====================================================================
+void ContractionHierarchy::add_shortcut (int the_from, int the_to,
+					 int the_weight, int the_middle)
+{
+	Arc arc;
+	int i;
+
+	for (i = 0; i < (int) my_out [the_from].size(); i++) {
+		if (my_out [the_from][i].vertex == the_to) break;
+	}
+
+	// Already there and no longer.
+	if (i < (int) my_out [the_from].size() &&
+	    my_out [the_from][i].weight <= the_weight)
+		return;
+
+	arc.vertex = the_to;
+	arc.weight = the_weight;
+	arc.middle = the_middle;
+	if (i < (int) my_out [the_from].size()) {
+		my_out [the_from][i] = arc;
+		remove_arc (my_in [the_to], the_from);
+	} else {
+		my_out [the_from].push_back (arc);
+	}
+	arc.vertex = the_from;
+	my_in [the_to].push_back (arc);
+	my_shortcuts++;
+}
+
+
+//========================contract====================================
+// Contracts the given vertex: adds its shortcuts, keeps its edges for
+// queries and removes it from its neighbors. Its remaining neighbors
+// are all contracted later, so its edges out of it are upward edges
+// and its edges into it are downward edges.
+//====================================================================
+void ContractionHierarchy::contract (int the_vertex)
+{
+	int i;
+
+	shortcuts (the_vertex, true);
+
+	my_up_lists [the_vertex]   = my_out [the_vertex];
+	my_down_lists [the_vertex] = my_in [the_vertex];
+
+	for (i = 0; i < (int) my_out [the_vertex].size(); i++)
+		remove_arc (my_in [my_out [the_vertex][i].vertex], the_vertex);
+	for (i = 0; i < (int) my_in [the_vertex].size(); i++)
+		remove_arc (my_out [my_in [the_vertex][i].vertex], the_vertex);
+
+	vector<Arc> ().swap (my_out [the_vertex]);
+	vector<Arc> ().swap (my_in [the_vertex]);
+}
+
+
+//========================remove_arc==================================
+// Removes the arc to the given vertex from the given list, by moving
+// the last arc into its place.
+//====================================================================
+void ContractionHierarchy::remove_arc (vector<Arc> &the_list, int the_vertex)
+{
+	int i;
+
+	for (i = 0; i < (int) the_list.size(); i++) {
+		if (the_list [i].vertex == the_vertex) {
+			the_list [i] = the_list.back();
+			the_list.pop_back();
+			return;
+		}
+	}
+}
+
+
+//========================flatten=====================================
+// Moves the given lists into CSR form: the arcs of vertex v end up at
+// indices offsets[v] up to offsets[v + 1]. The lists are emptied.
+//====================================================================
+void ContractionHierarchy::flatten (vector< vector<Arc> > &the_lists,
+				    vector<int> &the_offsets,
+				    vector<Arc> &the_arcs)
+{
+	int vertex;
+
+	the_offsets.assign (my_size + 2, 0);
+	the_arcs.clear();
+	for (vertex = 1; vertex <= my_size; vertex++) {
+		the_offsets [vertex] = (int) the_arcs.size();
+		the_arcs.insert (the_arcs.end(), the_lists [vertex].begin(),
+				 the_lists [vertex].end());
+		vector<Arc> ().swap (the_lists [vertex]);
+	}
+	the_offsets [my_size + 1] = (int) the_arcs.size();
+}
+
+
+//========================findPath====================================
+// Finds the shortest path from the first int to the second int. The
+// forward search from the start only takes edges up the ranks, and
+// the backward search from the finish only takes edges into it from
+// higher ranks. Every shortest path has a highest vertex where both
+// searches meet, and a side stops once its next distance is past the
+// best meeting found. The shortcuts on the path are then unpacked
+// into the original edges, so my_path holds the same kind of path
+// Graph::findPath would.
+//
+// Preconditions: build has been run.
+//
+// Postconditions: Returns the length of the path, or -1 if there is
+//		   none or a vertex does not exist.
+//====================================================================
+int ContractionHierarchy::findPath (int the_start_v, int the_finish_v)
+{
+	vector<int> chain;
+	int best = -1, meet = 0;
+	int vertex, i;
+	bool forward;
+
+	my_path.clear();
+	if (the_start_v < 1 || the_start_v > my_size ||
+	    the_finish_v < 1 || the_finish_v > my_size)
+		return -1;
+
+	start_search (my_forward, the_start_v);
+	start_search (my_backward, the_finish_v);
+
+	for (;;) {
+		// Take the side with the smaller next distance, if it
+		// can still improve the best meeting.
+		if (my_forward.heap.isEmpty()) {
+			if (my_backward.heap.isEmpty()) break;
+			forward = false;
+		} else if (my_backward.heap.isEmpty()) {
+			forward = true;
+		} else {
+			forward = my_forward.heap.topKey() <= my_backward.heap.topKey();
+		}
+		if (best != -1 && (forward ? my_forward : my_backward).heap.topKey() >= best)
+			break;
+
+		if (forward)
+			settle_next (my_forward, my_backward, my_up_offsets, my_up, best, meet);
+		else
+			settle_next (my_backward, my_forward, my_down_offsets, my_down, best, meet);
+	}
+	if (best == -1) return -1;
+
+	// The vertices from the start up to the meeting vertex.
+	for (vertex = meet; vertex != the_start_v; vertex = my_forward.parent [vertex])
+		chain.push_back (vertex);
+	chain.push_back (the_start_v);
+	reverse (chain.begin(), chain.end());
+
+	// Unpack the upward edges, then the downward ones from the
+	// meeting vertex to the finish.
+	my_path.push_back (the_start_v);
+	for (i = 1; i < (int) chain.size(); i++)
+		unpack (chain [i - 1], chain [i], my_up [my_forward.arc [chain [i]]].middle);
+	for (vertex = meet; vertex != the_finish_v; vertex = my_backward.parent [vertex])
+		unpack (vertex, my_backward.parent [vertex],
+			my_down [my_backward.arc [vertex]].middle);
+	return best;
+}
+
+
+//========================getPath=====================================
+// Returns the vertices of the last path found by findPath, in order.
+// It is empty if there was no path.
+//====================================================================
+const vector<int> &ContractionHierarchy::getPath () const
+{
+	return my_path;
+}
+
+
+//========================display=====================================
+// Displays the path from the first int to the second int exactly the
+// way Graph::display does: the two vertices, the distance, the path,
+// and the description of each vertex on it.
+//
+// Preconditions: build has been run.
+//
+// Postconditions: The path is displayed, or nothing if there is none.
+//====================================================================
+void ContractionHierarchy::display (int the_start_v, int the_finish_v)
+{
+	int distance = findPath (the_start_v, the_finish_v);
+	my_graph->display_path (my_path, distance);
+}
+
+
+//========================start_search================================
+// Clears the given search and starts it from the given vertex. Only
+// the vertices the last search reached are cleared.
+//====================================================================
+void ContractionHierarchy::start_search (Search &the_search, int the_source)
+{
+	int i;
+
+	if ((int) the_search.distance.size() != my_size + 1) {
+		the_search.distance.assign (my_size + 1, -1); // Not using index 0.
+		the_search.parent.assign (my_size + 1, 0);
+		the_search.arc.assign (my_size + 1, -1);
+		the_search.touched.clear();
+	}
+	for (i = 0; i < (int) the_search.touched.size(); i++)
+		the_search.distance [the_search.touched [i]] = -1;
+	the_search.touched.clear();
+	the_search.heap.reset (my_size);
+
+	the_search.touched.push_back (the_source);
+	the_search.distance [the_source] = 0;
+	the_search.parent [the_source]   = the_source;
+	the_search.arc [the_source]      = -1;
+	the_search.heap.push (the_source, 0);
+}
+
+
+//========================settle_next=================================
+// Settles the vertex at the top of the first search's heap. If the
+// second search has reached it, the two meet there and the best
+// meeting is kept in the ints: its length (-1 if none yet) and
+// vertex. Then the vertex's arcs in the given CSR arrays are relaxed.
+//====================================================================
+void ContractionHierarchy::settle_next (Search &the_search, Search &the_other,
+					const vector<int> &the_offsets,
+					const vector<Arc> &the_arcs,
+					int &the_best, int &the_meet)
+{
+	int vertex = the_search.heap.pop();
+
+	if (the_other.distance [vertex] != -1 &&
+	    (the_best == -1 || the_search.distance [vertex] + 
+	     the_other.distance [vertex] < the_best)) {
+		the_best = the_search.distance [vertex] + the_other.distance [vertex];
+		the_meet = vertex;
+	}
+	relax (the_search, vertex, the_offsets, the_arcs);
+}
+
+
+//========================relax=======================================
+// Relaxes the arcs of the given vertex in the given CSR arrays for 
+// the given search. They all lead up the ranks, so a settled vertex
+// is never reached again by a shorter path.
+//====================================================================
+void ContractionHierarchy::relax (Search &the_search, int the_vertex,
+				  const vector<int> &the_offsets,
+				  const vector<Arc> &the_arcs)
+{
+	int adjacent, distance, i, last;
+
+	last = the_offsets [the_vertex + 1];
+	for (i = the_offsets [the_vertex]; i < last; i++) {
+		adjacent = the_arcs [i].vertex;
+		distance = the_search.distance [the_vertex] + the_arcs [i].weight;
+
+		if (the_search.distance [adjacent] == -1) {
+			the_search.touched.push_back (adjacent);
+			the_search.heap.push (adjacent, distance);
+		} else if (distance < the_search.distance [adjacent] &&
+			   the_search.heap.contains (adjacent)) {
+			the_search.heap.decreaseKey (adjacent, distance);
+		} else {
+			continue;
+		}
+		the_search.distance [adjacent] = distance;
+		the_search.parent [adjacent]   = the_vertex;
+		the_search.arc [adjacent]      = i;
+	}
+}
+
+
+//========================search_all==================================
+// Settles every vertex the given search can reach in the given CSR
+// arrays. The upward search space of a vertex is small, so there is
+// no need to stop early. The reached vertices are left in touched.
+//====================================================================
+void ContractionHierarchy::search_all (Search &the_search, 
+				       const vector<int> &the_offsets,
+				       const vector<Arc> &the_arcs)
+{
+	while (!the_search.heap.isEmpty())
+		relax (the_search, the_search.heap.pop(), the_offsets, the_arcs);
+}
+
+
+//========================distanceMatrix==============================
+// Finds the distance from every source in the first vector to every
+// target in the second, and stores them in the int array row by row,
+// the way Graph::distanceMatrix does. Every shortest path has a 
+// highest vertex, reached going up from the source and going up 
+// backward from the target. So the backward search from each target
+// runs once, leaving (target, distance) in the bucket of every 
+// vertex it reaches. The forward search from each source then scans
+// the buckets of the vertices it reaches, and the shortest sum for a
+// target is the distance to it. That is S + T upward searches 
+// instead of S * T queries.
+//
+// Preconditions: build has been run, and the array holds 
+//		  sources.size() * targets.size() ints.
+//
+// Postconditions: Returns false, and stores nothing, if a vertex 
+//		   does not exist.
+//====================================================================
+bool ContractionHierarchy::distanceMatrix (const vector<int> &the_sources,
+					   const vector<int> &the_targets,
+					   int *the_matrix)
+{
+	BucketEntry entry;
+	int i, j, k, vertex, distance, columns = (int) the_targets.size();
+	int *row;
+
+	for (i = 0; i < (int) the_sources.size(); i++) {
+		if (the_sources [i] < 1 || the_sources [i] > my_size) 
+			return false;
+	}
+	for (j = 0; j < columns; j++) {
+		if (the_targets [j] < 1 || the_targets [j] > my_size) 
+			return false;
+	}
+	if ((int) my_buckets.size() != my_size + 1)
+		my_buckets.assign (my_size + 1, vector<BucketEntry> ()); // Not using index 0.
+
+	// Fill the buckets from the targets.
+	for (j = 0; j < columns; j++) {
+		start_search (my_backward, the_targets [j]);
+		search_all (my_backward, my_down_offsets, my_down);
+		for (k = 0; k < (int) my_backward.touched.size(); k++) {
+			vertex = my_backward.touched [k];
+			if (my_buckets [vertex].empty()) 
+				my_bucket_vertices.push_back (vertex);
+			entry.target   = j;
+			entry.distance = my_backward.distance [vertex];
+			my_buckets [vertex].push_back (entry);
+		}
+	}
+
+	// Scan them from the sources.
+	for (i = 0; i < (int) the_sources.size(); i++) {
+		row = the_matrix + (long long) i * columns;
+		for (j = 0; j < columns; j++) row [j] = -1;
+
+		start_search (my_forward, the_sources [i]);
+		search_all (my_forward, my_up_offsets, my_up);
+		for (k = 0; k < (int) my_forward.touched.size(); k++) {
+			vertex = my_forward.touched [k];
+			vector<BucketEntry> &bucket = my_buckets [vertex];
+			for (j = 0; j < (int) bucket.size(); j++) {
+				distance = my_forward.distance [vertex] + bucket [j].distance;
+				if (row [bucket [j].target] == -1 || 
+				    distance < row [bucket [j].target])
+					row [bucket [j].target] = distance;
+			}
+		}
+	}
+
+	// Leave the buckets empty for the next call.
+	for (k = 0; k < (int) my_bucket_vertices.size(); k++)
+		my_buckets [my_bucket_vertices [k]].clear();
+	my_bucket_vertices.clear();
+	return true;
+}
+
+
+//========================unpack======================================
+// Appends the vertices of the edge from the first int to the second
+// int to my_path, without the first one. The third int is the vertex
+// the edge skips, -1 for an original edge. A shortcut a -> b that 
+// skips m stands for a -> m and m -> b, both of which were kept when
+// m was contracted: a -> m among m's downward arcs and m -> b among
+// its upward ones. Those may be shortcuts too, so the edges still to
+// unpack are kept on a stack, the next one on top, instead of
+// recursing once per level of the hierarchy.
+//====================================================================
+void ContractionHierarchy::unpack (int the_from, int the_to, int the_middle)
+{
+	vector<Arc> stack;
+	Arc edge, first, second;
+	int from;
+
+	// The stack holds the ends of the edges; from is the start of
+	// the one on top, which is the last vertex on the path.
+	edge.vertex = the_to;
+	edge.weight = 0;
+	edge.middle = the_middle;
+	stack.push_back (edge);
+	from = the_from;
+
+	while (!stack.empty()) {
+		edge = stack.back();
+		stack.pop_back();
+
+		if (edge.middle == -1) {
+			my_path.push_back (edge.vertex);
+			from = edge.vertex;
+			continue;
+		}
+
+		// Split it, putting the second half under the first.
+		second = find_arc (my_up_offsets, my_up, edge.middle, edge.vertex);
+		first  = find_arc (my_down_offsets, my_down, edge.middle, from);
+		stack.push_back (second);
+		first.vertex = edge.middle;
+		stack.push_back (first);
+	}
+}
+
+
+//========================find_arc====================================
+// Returns the arc to the given vertex in the run of the CSR arrays of
+// the vertex given first.
+//
+// Preconditions: The arc is there.
+//====================================================================
+const ContractionHierarchy::Arc &ContractionHierarchy::find_arc (
+	const vector<int> &the_offsets, const vector<Arc> &the_arcs,
+	int the_vertex, int the_other)
+{
+	int i = the_offsets [the_vertex];
+
+	while (the_arcs [i].vertex != the_other)
+		i++;
+	return the_arcs [i];
+}
@@ -0,0 +1,318 @@
+//====================================================================
+// ContractionHierarchy.h
+//
+// This class represents a contraction hierarchy of a Graph. The
+// vertices are ranked by importance and contracted from the least
+// important up. Contracting a vertex removes it from the graph and
+// adds a shortcut edge between two of its neighbors wherever the
+// shortest path between them went through it. Afterwards every
+// shortest path can be found going only up the ranks from the start
+// and only up the ranks backward from the finish, so a query settles
+// a few hundred vertices instead of the whole graph.
+//====================================================================
+// ContractionHierarchy class:
+//   Includes following features:
+// 	- allows building the hierarchy of a graph.
+//	- allows finding the shortest path between two vertices.
+//	- allows displaying a path the way Graph::display does.
+//	- allows finding the distances from a set of sources to a set
+//	  of targets.
+// Assumptions:
+// 	- the graph is not changed or destroyed after build, otherwise
+//	  build has to be run again.
+//	- edge weights are not negative.
+//====================================================================
+
+#ifndef _CONTRACTIONHIERARCHY_H
+#define _CONTRACTIONHIERARCHY_H
+#include "Graph.h"
+#include "Heap.h"
+#include <vector>
+using namespace std;
+
+class ContractionHierarchy {
+
+public:
+
+	//========================Default-Constructor=================
+	// Creates an empty ContractionHierarchy. No path is found
+	// until build is run.
+	//
+	// Preconditions: None.
+	//
+	// Postconditions: The hierarchy has no vertices.
+	//============================================================
+	ContractionHierarchy ();
+
+
+	//========================build===============================
+	// Orders the vertices of the graph, contracts them in that
+	// order, and keeps the upward and downward edges, shortcuts
+	// included, for queries.
+	//
+	// Preconditions: The graph is built.
+	//
+	// Postconditions: Paths of the graph can be found.
+	//============================================================
+	void build (Graph &);
+
+
+	//========================getShortcutCount====================
+	// Returns the number of shortcuts added by build.
+	//============================================================
+	int getShortcutCount () const;
+
+
+	//========================findPath============================
+	// Finds the shortest path from the first int to the second
+	// int with an upward search from each end, and unpacks its
+	// shortcuts into the original edges.
+	//
+	// Preconditions: build has been run.
+	//
+	// Postconditions: Returns the length of the path, or -1 if
+	//		   there is none or a vertex does not exist.
+	//============================================================
+	int findPath (int, int);
+
+
+	//========================getPath=============================
+	// Returns the vertices of the last path found by findPath,
+	// in order. It is empty if there was no path.
+	//============================================================
+	const vector<int> &getPath () const;
+
+
+	//========================display=============================
+	// Displays the path from the first int to the second int
+	// exactly the way Graph::display does.
+	//
+	// Preconditions: build has been run.
+	//
+	// Postconditions: The path is displayed, or nothing if there
+	//		   is none.
+	//============================================================
+	void display (int, int);
+
+
+	//========================distanceMatrix======================
+	// Finds the distance from every source in the first vector to
+	// every target in the second, and stores them in the int 
+	// array row by row, the way Graph::distanceMatrix does. The
+	// backward search from each target runs once and leaves its
+	// distances in buckets at the vertices it reaches. The forward
+	// search from each source then only reads the buckets of the
+	// vertices it reaches, so the work for the targets is shared
+	// by every source.
+	//
+	// Preconditions: build has been run, and the array holds
+	//		  sources.size() * targets.size() ints.
+	//
+	// Postconditions: Returns false, and stores nothing, if a
+	//		   vertex does not exist.
+	//============================================================
+	bool distanceMatrix (const vector<int> &, const vector<int> &, int *);
+
+private:
+
+	// An edge of the hierarchy.
+	struct Arc {
+		// The vertex at the other end.
+		int vertex;
+		// The weight of the edge.
+		int weight;
+		// The vertex a shortcut skips, -1 for an original edge.
+		int middle;
+	};
+
+	// One direction of a query. Only the vertices in touched have
+	// been given a distance.
+	struct Search {
+		// The shortest known distance, -1 if not reached yet.
+		vector<int> distance;
+		// The vertex each one was reached from, and the index 
+		// of the arc used, -1 for the one the search started
+		// from.
+		vector<int> parent;
+		vector<int> arc;
+		// The vertices reached by the last search.
+		vector<int> touched;
+		// The vertices reached but not settled.
+		Heap heap;
+	};
+
+	// The distance from a vertex to a target of distanceMatrix,
+	// left in the vertex's bucket by the target's backward search.
+	struct BucketEntry {
+		// The index of the target.
+		int target;
+		// The distance from the vertex to the target.
+		int distance;
+	};
+
+	// The most vertices a witness search may settle. A search
+	// that gives up adds a shortcut that may not be needed, which
+	// costs a little query time but never a wrong answer.
+	static const int WITNESS_LIMIT = 200;
+
+
+	//========================order===============================
+	// Contracts every vertex, least important first, using a
+	// queue keyed by priority that is updated lazily.
+	//============================================================
+	void order ();
+
+
+	//========================priority============================
+	// Returns how important the given vertex is: the shortcuts
+	// contracting it would add, less the edges it would remove,
+	// plus the number of its neighbors already contracted.
+	//============================================================
+	int priority (int);
+
+
+	//========================shortcuts===========================
+	// Returns the number of shortcuts contracting the given vertex
+	// needs. If the bool is true they are added as well.
+	//============================================================
+	int shortcuts (int, bool);
+
+
+	//========================witness_search======================
+	// Runs Dijkstra's algorithm from the first int over the
+	// vertices not yet contracted, avoiding the second int and
+	// stopping past the distance in the third int.
+	//============================================================
+	void witness_search (int, int, int);
+
+
+	//========================add_shortcut========================
+	// Adds the edge from the first int to the second int with the
+	// third int as its weight and the fourth int as the vertex it
+	// skips, or lowers the weight of the edge already there.
+	//============================================================
+	void add_shortcut (int, int, int, int);
+
+
+	//========================contract============================
+	// Contracts the given vertex: adds its shortcuts, keeps its
+	// edges for queries and removes it from its neighbors.
+	//============================================================
+	void contract (int);
+
+
+	//========================remove_arc==========================
+	// Removes the arc to the given vertex from the given list.
+	//============================================================
+	static void remove_arc (vector<Arc> &, int);
+
+
+	//========================flatten=============================
+	// Moves the given lists into CSR form: the arcs of vertex v
+	// end up at indices offsets[v] up to offsets[v + 1].
+	//============================================================
+	void flatten (vector< vector<Arc> > &, vector<int> &,
+		      vector<Arc> &);
+
+
+	//========================start_search========================
+	// Clears the given search and starts it from the given
+	// vertex.
+	//============================================================
+	void start_search (Search &, int);
+
+
+	//========================settle_next=========================
+	// Settles the vertex at the top of the first search's heap,
+	// meets the second search there if that reached it, and
+	// relaxes its arcs in the given CSR arrays. The best meeting
+	// is kept in the ints: its length (-1 if none) and vertex.
+	//============================================================
+	void settle_next (Search &, Search &, const vector<int> &,
+			  const vector<Arc> &, int &, int &);
+
+
+	//========================relax===============================
+	// Relaxes the arcs of the given vertex in the given CSR arrays
+	// for the given search.
+	//============================================================
+	void relax (Search &, int, const vector<int> &, 
+		    const vector<Arc> &);
+
+
+	//========================search_all==========================
+	// Settles every vertex the given search can reach in the 
+	// given CSR arrays. The reached vertices are left in touched.
+	//============================================================
+	void search_all (Search &, const vector<int> &, 
+			 const vector<Arc> &);
+
+
+	//========================unpack==============================
+	// Appends the vertices of the edge from the first int to the
+	// second int to my_path, without the first one, replacing
+	// each shortcut by the two edges it skips.
+	//============================================================
+	void unpack (int, int, int);
+
+
+	//========================find_arc============================
+	// Returns the arc to the second int in the run of the CSR 
+	// arrays of the first int.
+	//============================================================
+	static const Arc &find_arc (const vector<int> &, const vector<Arc> &,
+				    int, int);
+
+
+	// The graph the hierarchy was built from, used for the
+	// descriptions of the vertices.
+	const Graph *my_graph;
+
+	// The number of vertices in the graph.
+	int my_size;
+
+	// The number of shortcuts added by build.
+	int my_shortcuts;
+
+	// The position of each vertex in the contraction order.
+	vector<int> my_rank;
+
+	// The arcs of vertex v to vertices ranked above it are at
+	// my_up_offsets[v] up to my_up_offsets[v + 1] of my_up.
+	vector<int> my_up_offsets;
+	vector<Arc> my_up;
+
+	// The arcs into vertex v from vertices ranked above it, with
+	// the vertex they come from, are at my_down_offsets[v] up to
+	// my_down_offsets[v + 1] of my_down.
+	vector<int> my_down_offsets;
+	vector<Arc> my_down;
+
+	// The graph left while contracting: the arcs leaving and
+	// entering each vertex not yet contracted. Empty after build.
+	vector< vector<Arc> > my_out;
+	vector< vector<Arc> > my_in;
+
+	// The arcs kept for queries while contracting.
+	vector< vector<Arc> > my_up_lists;
+	vector< vector<Arc> > my_down_lists;
+
+	// The number of neighbors of each vertex contracted so far.
+	vector<int> my_contracted_neighbors;
+
+	// The witness search, reused for every vertex.
+	Search my_witness;
+
+	// The forward and backward searches of findPath.
+	Search my_forward;
+	Search my_backward;
+
+	// The vertices of the last path found by findPath, in order.
+	vector<int> my_path;
+
+	// The buckets of distanceMatrix, one per vertex, and the 
+	// vertices whose bucket is not empty.
+	vector< vector<BucketEntry> > my_buckets;
+	vector<int> my_bucket_vertices;
+};
+#endif /* _CONTRACTIONHIERARCHY_H */
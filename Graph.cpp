@@ -2,8 +2,9 @@
 // Graph.h 
 //  
 // This class represents a Graph that is implemented using an 
-// adjacency list. A graph can not have more than 100 edges. 
-// The entire graph can be displayed or a specific path can be 
+// adjacency list. Storage is sized from the number of vertices
+// read in buildGraph, so there is no fixed limit on the size of a
+// graph. The entire graph can be displayed or a specific path can be 
 // displayed. 
 // 
 // Author: John Steele <steelejr@u.washington.edu> 
@@ -20,13 +21,30 @@
 //	- allows dislplaying the graph from one vertex to another. 
 // Assumptions:
 // 	- input is properly formatted. 
-//	- description of each vertex is no longer than 50 characters.
 //	- each line following the description contains three ints
 //	  representing an edge. 
 //	- a zero for the first integer signals the end of the data. 
 //====================================================================
 
 #include "Graph.h"
+#include "TextReader.h" // buildGraph parsing.
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close
+#include <string.h>    // memcmp, memcpy
+#include <algorithm>   // reverse, sort
+#include "MinimumScan.h"
+#include "OutputBuffer.h"
+
+
+// The first bytes of a file written by saveBinary.
+template <class W, class D>
+const char BasicGraph<W, D>::BINARY_MAGIC [9] = "DIJKSTRA";
+
+// The largest distance, so nothing reached compares greater.
+template <class W, class D>
+const D BasicGraph<W, D>::INFINITE = numeric_limits<D>::max();
 
 
 //========================Default-Constructor=========================
@@ -37,7 +55,16 @@
 // Postconditions: this Graph object is instantiated with 
 //    		   default values. 
 //====================================================================
-Graph::Graph (){}
+template <class W, class D>
+BasicGraph<W, D>::BasicGraph () : my_error_line (0), my_error_message (""),
+		  my_size (0), my_free_edges (NULL), my_out_offsets (NULL), 
+		  my_out_targets (NULL), my_out_weights (NULL),
+		  my_compiled (false), my_reverse_compiled (false),
+		  my_mapping (NULL), my_mapping_size (0), 
+		  my_desc_offsets (NULL), my_desc_pool (NULL), my_lazy (false),
+		  my_rows_computed (0), my_strategy (AUTO), 
+		  my_max_weight (0), my_max_weight_known (true), my_threads (1), 
+		  my_settled (0) {}
 
 
 //========================Copy-Constructor============================
@@ -50,63 +77,176 @@ Graph::Graph (){}
 // Postconditions: this Graph object is instantiated with its data
 //		   members set to the_other's. 
 //====================================================================
-Graph::Graph (const Graph &the_other)
+template <class W, class D>
+BasicGraph<W, D>::BasicGraph (const BasicGraph &the_other) 
+	: my_error_line (0), my_error_message (""),
+	  my_size (0), my_free_edges (NULL), my_out_offsets (NULL), 
+	  my_out_targets (NULL), my_out_weights (NULL), my_compiled (false), 
+	  my_reverse_compiled (false), my_mapping (NULL), my_mapping_size (0),
+	  my_desc_offsets (NULL), my_desc_pool (NULL),
+	  my_lazy (the_other.my_lazy),
+	  my_rows_computed (0), my_strategy (the_other.my_strategy), 
+	  my_heap (the_other.my_heap.getArity()),
+	  my_max_weight (the_other.my_max_weight),
+	  my_max_weight_known (the_other.my_max_weight_known),
+	  my_threads (the_other.my_threads), my_settled (0),
+	  my_external_ids (the_other.my_external_ids),
+	  my_internal_ids (the_other.my_internal_ids)
 {
-	int row, col;
-	EdgeNode *edge_cur;
-	EdgeNode *edge;
-	EdgeNode *current;
+	int row;
+
+	// A mapped graph or snapshot has no lists to copy, so build
+	// them from its CSR arrays and string pool instead.
+	if (the_other.my_vertices.empty() && the_other.my_size > 0) {
+		my_size         = the_other.my_size;
+		my_csr          = the_other.my_csr;
+		my_descriptions = the_other.my_descriptions;
+		my_description_ids = the_other.my_description_ids;
+		my_out_offsets  = the_other.my_out_offsets;
+		my_out_targets  = the_other.my_out_targets;
+		my_out_weights  = the_other.my_out_weights;
+		my_desc_offsets = the_other.my_desc_offsets;
+		my_desc_pool    = the_other.my_desc_pool;
+		materialize();
+		my_table = the_other.my_table;
+		my_rows_computed = the_other.my_rows_computed;
+		return;
+	}
+
+	resize_storage (the_other.my_size);
+
+	// Everything copied fits in one slab.
+	my_arena.reserve (the_other.my_arena.getBytesUsed());
 	
-	// Copy the adjacency list.
+	// Copy the adjacency lists.
 	for (row = 1; row <= the_other.my_size; row++) {
 		
-		// Copy the vertex description Object.
-		my_vertices[row].data = new Object (*the_other.my_vertices[row].data);
-		my_vertices[row].edgeHead = NULL;
-
-		// Get the head of the other list. 	
-		edge_cur = the_other.my_vertices[row].edgeHead;
-	
-		// Special case, copy the head.	
-		if (edge_cur) {
-			my_vertices[row].edgeHead            = new EdgeNode;
-			my_vertices[row].edgeHead->adjVertex = edge_cur->adjVertex;
-			my_vertices[row].edgeHead->weight    = edge_cur->weight;
-			my_vertices[row].edgeHead->nextEdge  = NULL;
-			current = my_vertices[row].edgeHead;
-			edge_cur = edge_cur->nextEdge;
-		}	
-
-		// Now do the normal traversal.	
-		while (edge_cur) {	
-			edge            = new EdgeNode;
-			edge->adjVertex = edge_cur->adjVertex;
-			edge->weight    = edge_cur->weight;
-			edge->nextEdge  = NULL; 
-	
-			// Link it in.
-			current->nextEdge = edge;	
-			// Move current to the new last edge.
-			current = current->nextEdge;
-			// Move to the next edge in the_other.
-			edge_cur = edge_cur->nextEdge;
-		}
+		// Copy the lists of edges leaving and entering it.
+		my_vertices[row].edgeHead = 
+			copy_list (the_other.my_vertices[row].edgeHead);
+		my_vertices[row].reverseHead = 
+			copy_list (the_other.my_vertices[row].reverseHead);
 	}	
 
-	my_size = the_other.my_size;
+	// Copy the table, only the rows that were computed take space.
+	my_table = the_other.my_table;
+	my_rows_computed = the_other.my_rows_computed;
 
-	init_table();
-	// Copy the table.	
-	for (row = 1; row <= my_size; row++) {
-		for (col = 1; col <= my_size; col++) {
-			my_table[row][col].isVisited =	
-				 the_other.my_table[row][col].isVisited;	
-			my_table[row][col].distance  =
-				 the_other.my_table[row][col].distance;
-			my_table[row][col].prev_vertex =
-				 the_other.my_table[row][col].prev_vertex;
-		}	
-	}	
+	// Share the CSR arrays, they are copied on write.
+	my_csr          = the_other.my_csr;
+	my_compiled     = the_other.my_compiled;
+	use_owned_csr();
+
+	// Share the descriptions, they never change.
+	my_descriptions    = the_other.my_descriptions;
+	my_description_ids = the_other.my_description_ids;
+
+	my_in_offsets       = the_other.my_in_offsets;
+	my_in_sources       = the_other.my_in_sources;
+	my_in_weights       = the_other.my_in_weights;
+	my_reverse_compiled = the_other.my_reverse_compiled;
+}
+
+
+//========================Move-Constructor============================
+// Creates a Graph object that takes over the_other's data without
+// copying it, by swapping with a new empty graph.
+// 
+// Preconditions: None.
+//		
+// Postconditions: this Graph object holds what the_other held, and 
+//		   the_other is empty.
+//====================================================================
+template <class W, class D>
+BasicGraph<W, D>::BasicGraph (BasicGraph &&the_other) : BasicGraph ()
+{
+	swap (the_other);
+}
+
+
+//========================operator=====================================
+// Makes this graph a copy of the_other. The copy is made first, so 
+// assigning a graph to itself is safe, and this graph's old data is
+// released when the copy goes out of scope.
+// 
+// Preconditions: None.
+//		
+// Postconditions: This graph's old data has been released.
+//====================================================================
+template <class W, class D>
+BasicGraph<W, D> &BasicGraph<W, D>::operator= (const BasicGraph &the_other)
+{
+	BasicGraph copy (the_other);
+	swap (copy);
+	return *this;
+}
+
+
+//========================operator=====================================
+// Makes this graph take over the_other's data without copying it.
+// 
+// Preconditions: None.
+//		
+// Postconditions: This graph's old data has been released, and 
+//		   the_other is empty.
+//====================================================================
+template <class W, class D>
+BasicGraph<W, D> &BasicGraph<W, D>::operator= (BasicGraph &&the_other)
+{
+	BasicGraph taken (std::move (the_other));
+	swap (taken);
+	return *this;
+}
+
+
+//========================swap========================================
+// Exchanges the data of this graph and the_other. The CSR views 
+// point into my_csr or a mapping, and the edge lists into my_arena,
+// and none of those move in memory, so every pointer stays valid.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::swap (BasicGraph &the_other)
+{
+	std::swap (my_error_line, the_other.my_error_line);
+	std::swap (my_error_message, the_other.my_error_message);
+	my_vertices.swap (the_other.my_vertices);
+	std::swap (my_size, the_other.my_size);
+	my_arena.swap (the_other.my_arena);
+	std::swap (my_free_edges, the_other.my_free_edges);
+	my_csr.swap (the_other.my_csr);
+	std::swap (my_out_offsets, the_other.my_out_offsets);
+	std::swap (my_out_targets, the_other.my_out_targets);
+	std::swap (my_out_weights, the_other.my_out_weights);
+	std::swap (my_compiled, the_other.my_compiled);
+	my_in_offsets.swap (the_other.my_in_offsets);
+	my_in_sources.swap (the_other.my_in_sources);
+	my_in_weights.swap (the_other.my_in_weights);
+	std::swap (my_reverse_compiled, the_other.my_reverse_compiled);
+	std::swap (my_mapping, the_other.my_mapping);
+	std::swap (my_mapping_size, the_other.my_mapping_size);
+	std::swap (my_desc_offsets, the_other.my_desc_offsets);
+	std::swap (my_desc_pool, the_other.my_desc_pool);
+	my_descriptions.swap (the_other.my_descriptions);
+	my_description_ids.swap (the_other.my_description_ids);
+	std::swap (my_lazy, the_other.my_lazy);
+	my_table.swap (the_other.my_table);
+	std::swap (my_rows_computed, the_other.my_rows_computed);
+	std::swap (my_strategy, the_other.my_strategy);
+	std::swap (my_heap, the_other.my_heap);
+	std::swap (my_buckets, the_other.my_buckets);
+	std::swap (my_radix, the_other.my_radix);
+	std::swap (my_max_weight, the_other.my_max_weight);
+	std::swap (my_max_weight_known, the_other.my_max_weight_known);
+	std::swap (my_threads, the_other.my_threads);
+	std::swap (my_forward, the_other.my_forward);
+	std::swap (my_backward, the_other.my_backward);
+	my_path.swap (the_other.my_path);
+	std::swap (my_settled, the_other.my_settled);
+	my_found.swap (the_other.my_found);
+	my_found_distances.swap (the_other.my_found_distances);
+	my_external_ids.swap (the_other.my_external_ids);
+	my_internal_ids.swap (the_other.my_internal_ids);
+	my_predecessors.swap (the_other.my_predecessors);
 }
 
 
@@ -117,7 +257,8 @@ Graph::Graph (const Graph &the_other)
 //		
 // Postconditions: All resources have been released. 
 //====================================================================
-Graph::~Graph ()
+template <class W, class D>
+BasicGraph<W, D>::~BasicGraph ()
 {
 	delete_vertices();	
 }
@@ -126,6 +267,10 @@ Graph::~Graph ()
 //========================delete_vertices=============================
 // A helper method for the deconstructor. It deletes all dynamic
 // memory within my_vertices.  
+//
+// Every EdgeNode is in my_arena, so they are released together 
+// instead of walking the lists node by node. EdgeNode has no 
+// destructor to run, so skipping it is safe.
 // 
 // Preconditions: my_size is set to the number of vertices in the 
 //		  graph.
@@ -133,53 +278,270 @@ Graph::~Graph ()
 // Postconditions: All dynamic memory has been deleted from 
 //		   my_vertices.
 //====================================================================
-void Graph::delete_vertices () 
+template <class W, class D>
+void BasicGraph<W, D>::delete_vertices () 
 {
-	int row;
-	EdgeNode    *edge_cur;
-	EdgeNode    *junk;
-	
-	// Deallocate the adjacency list.
-	for (row = 1; row <= my_size; row++) {
-	
-		// Delete the vertex Object.
-		delete my_vertices[row].data;
-		my_vertices[row].data = NULL;
-
-		// Now go through the list.
-		edge_cur = my_vertices[row].edgeHead;
-		my_vertices[row].edgeHead = NULL;	
-
-		while (edge_cur != NULL) {
-			junk = edge_cur;
-			edge_cur = edge_cur->nextEdge; 
-			junk->nextEdge = NULL;
-			delete junk;			
-		} // end while (edge_cur != NULL) 
-	}	
+	// Release the edges and the storage itself.
+	my_arena.release();
+	my_free_edges = NULL;
+	my_vertices.clear();
+	my_table.clear();
+	my_rows_computed = 0;
+	my_max_weight = 0;
+	my_max_weight_known = true;
+	my_csr.reset();
+	my_descriptions.reset();
+	my_description_ids.reset();
+	use_owned_csr();
+	my_compiled = false;
+	my_in_offsets.clear();
+	my_in_sources.clear();
+	my_in_weights.clear();
+	my_reverse_compiled = false;
+	my_external_ids.clear();
+	my_internal_ids.clear();
+	my_predecessors.clear();
+	unmap();
+	my_size = 0;
+}
+
+
+//========================copy_list===================================
+// Returns a copy of the given list of edges, in the same order.
+// 
+// Preconditions: None.
+//		  		  		
+// Postconditions: The copy shares no nodes with the given list.
+//====================================================================
+template <class W, class D>
+typename BasicGraph<W, D>::EdgeNode *
+BasicGraph<W, D>::copy_list (const EdgeNode *the_head)
+{
+	EdgeNode *head;
+	EdgeNode *edge;
+	EdgeNode *current;
+
+	head = current = NULL;
+	while (the_head) {	
+		edge = new_edge (the_head->adjVertex, the_head->weight, NULL);
+
+		// Link it in after the last edge copied.
+		if (current == NULL)
+			head = edge;
+		else
+			current->nextEdge = edge;	
+		current = edge;
+
+		// Move to the next edge to copy.
+		the_head = the_head->nextEdge;
+	}
+	return head;
+}
+
+
+//========================new_edge====================================
+// Returns an EdgeNode to the vertex the int, with the given weight,
+// linked to the given next edge. An edge freed by removeEdge is 
+// reused if there is one, otherwise it comes from my_arena.
+//====================================================================
+template <class W, class D>
+typename BasicGraph<W, D>::EdgeNode *
+BasicGraph<W, D>::new_edge (int the_vertex, W the_weight, EdgeNode *the_next)
+{
+	EdgeNode *edge;
+
+	if (my_free_edges) {
+		edge          = my_free_edges;
+		my_free_edges = edge->nextEdge;
+	} else {
+		edge = (EdgeNode *) my_arena.allocate (sizeof (EdgeNode));
+	}
+	edge->adjVertex = the_vertex;
+	edge->weight    = the_weight;
+	edge->nextEdge  = the_next;
+	return edge;
+}
+
+
+//========================free_edge===================================
+// Keeps the given unlinked edge for new_edge to reuse. The arena can
+// not take back a single edge.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::free_edge (EdgeNode *the_edge)
+{
+	the_edge->nextEdge = my_free_edges;
+	my_free_edges      = the_edge;
+}
+
+
+//========================unlink_edge=================================
+// Removes the edge to the given vertex from the list starting at the
+// given head, and returns it. Returns NULL if there is no such edge.
+// 
+// Preconditions: None.
+//		  		  		
+// Postconditions: The returned edge is no longer in the list.
+//====================================================================
+template <class W, class D>
+typename BasicGraph<W, D>::EdgeNode *
+BasicGraph<W, D>::unlink_edge (EdgeNode *&the_head, int the_vertex)
+{
+	EdgeNode *cur, *prev;
+
+	prev = NULL;
+	cur  = the_head; 	
+	while (cur != NULL) {
+		if (cur->adjVertex == the_vertex) {
+			// We found the edge, link prev to next.
+			if (prev == NULL)
+				the_head = cur->nextEdge;
+			else
+				prev->nextEdge = cur->nextEdge;	
+			cur->nextEdge = NULL;
+			return cur;
+		}
+		prev = cur;
+		cur  = cur->nextEdge;	
+	} 
+	return NULL;
+}
+
+
+//========================find_edge===================================
+// Returns the edge to the given vertex in the list starting at the 
+// given head, or NULL if there is no such edge.
+//====================================================================
+template <class W, class D>
+typename BasicGraph<W, D>::EdgeNode *
+BasicGraph<W, D>::find_edge (EdgeNode *the_head, int the_vertex)
+{
+	while (the_head != NULL && the_head->adjVertex != the_vertex)
+		the_head = the_head->nextEdge;
+	return the_head;
 }
 
 
 //========================init_table==================================
-// Initializes the table of shortes paths.
+// Initializes the table of shortes paths. Sizes it to one row per
+// vertex and releases every row, so no source has been solved yet.
+// 
+// Preconditions: None.
+//		
+// Postconditions: The table has been initialized.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::init_table ()
+{
+	my_table.clear();
+	my_table.resize (my_size + 1); // Not using index 0.
+	my_rows_computed = 0;
+}
+
+
+//========================init_row====================================
+// Allocates the row of the table for the given source vertex if 
+// needed and initializes every entry of it.
 // 	1.) Sets visited to false.
-//	2.) Sets the initial distance to -1.
+//	2.) Sets the initial distance to INFINITE.
 //	3.) Sets previous vertex to zero.
 // 
+// Preconditions: The table has one row per vertex.
+//		
+// Postconditions: The row has been initialized.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::init_row (int the_source)
+{
+	if (my_table [the_source].distance.empty()) my_rows_computed++;
+	reset_row (the_source);
+}
+
+
+//========================reset_row===================================
+// Initializes every entry of the given source's row like init_row,
+// but does not count it as computed. Safe to call from a worker
+// thread as long as no other thread touches the same row.
+// 
+// Preconditions: The table has one row per vertex.
+//		
+// Postconditions: The row has been initialized.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::reset_row (int the_source)
+{
+	Row &row = my_table [the_source];
+	row.distance.assign (my_size + 1, INFINITE);
+	row.prev_vertex.assign (my_size + 1, 0);
+	row.visited.assign (my_size + 1, false);
+}
+
+
+//========================get_distance================================
+// Returns the distance in the table from the first int to the second
+// int, or -1 if there is no path or the row for the first int has not
+// been computed.
+//====================================================================
+template <class W, class D>
+D BasicGraph<W, D>::get_distance (int the_source, int the_dest) const
+{
+	D distance;
+
+	if (the_source >= (int) my_table.size() || 
+	    my_table [the_source].distance.empty()) return -1;
+	distance = my_table [the_source].distance [the_dest];
+	return (distance == INFINITE) ? -1 : distance;
+}
+
+
+//========================add_weight==================================
+// Returns the distance plus the weight, or INFINITE if the sum does
+// not fit in a D. A path has fewer than INT_MAX edges, so a D at
+// least 32 bits wider than W always holds the sum, and a floating 
+// point D only rounds it; for those the test is a constant and 
+// compiles away.
+//====================================================================
+template <class W, class D>
+inline D BasicGraph<W, D>::add_weight (D the_distance, W the_weight)
+{
+	if (!numeric_limits<D>::is_integer || sizeof (D) >= sizeof (W) + sizeof (int))
+		return the_distance + the_weight;
+	if ((D) the_weight >= INFINITE - the_distance) return INFINITE;
+	return the_distance + the_weight;
+}
+
+
+//========================resize_storage==============================
+// Grows my_vertices and my_table to hold the given number of
+// vertices. Vertices that already exist are kept, new ones have no
+// description and no edges.
+// 
 // Preconditions: None.
 //		
-// Postconditions: The table has been initialized.
+// Postconditions: Vertices 1 to the given int can be used.
 //====================================================================
-void Graph::init_table ()
+template <class W, class D>
+void BasicGraph<W, D>::resize_storage (int the_size)
 {
-	int row, col; 
-	for (row = 1; row < MAX_VERTICES; row++) {
-		for (col = 1; col < MAX_VERTICES; col++) {
-			my_table [row][col].isVisited   = false;
-			my_table [row][col].distance    = -1;
-			my_table [row][col].prev_vertex = 0;
-		}
+	VertexNode empty;
+	int row;
+
+	if (the_size <= my_size) return;
+
+	empty.edgeHead    = NULL;
+	empty.reverseHead = NULL;
+	my_vertices.resize (the_size + 1, empty); // Not using index 0.
+
+	// Computed rows have to grow with the graph. The new 
+	// vertices have no edges, so they can not be reached.
+	my_table.resize (the_size + 1);
+	for (row = 1; row <= my_size; row++) {
+		if (my_table [row].distance.empty()) continue;
+		my_table [row].distance.resize (the_size + 1, INFINITE);
+		my_table [row].prev_vertex.resize (the_size + 1, 0);
+		my_table [row].visited.resize (the_size + 1, false);
 	}
+	my_size = the_size;
 }
 
 
@@ -189,423 +551,2903 @@ void Graph::init_table ()
 // The format of the stream should be as follows: 
 //	- The first line is the number of vertices.  
 //	- Flollowing is a text description for each vertex.  
-//	  (One description per line, and 50 chars max length)
+//	  (One description per line, of any length)
 //	- After that, each line has 3 ints representing an edge.
 //	  (first int is from, second int is to, third int is weight) 
 //	- A zero for the first int of the three signals end of data. 
+//
+// The stream is read in large blocks by a TextReader and the ints 
+// are scanned by hand rather than with >>. Blank lines before the
+// number of vertices and between edges are skipped. The edges are 
+// staged and linked in with bulk_insert, and the shortest paths are
+// found once at the end (or not at all in lazy mode), so loading is
+// linear in the size of the input. The stream is left just after the
+// line that ended the data, so several graphs can be read in a row.
 // 
 // Preconditions: The input file stream should be open. It should be
 //		  properly formatted, and be organize as described 
 //		  above. 
 //		
 // Postconditions: The graph is built using the data from the provided
-//		   stream.
+//		   stream and true is returned. An edge with a vertex 
+//		   out of range or a weight that is negative or does 
+//		   not fit W is skipped and the rest are read. A line
+//		   that can not be parsed stops the load, and the graph
+//		   holds what was read before it. Either way false is 
+//		   returned, and errorLine and errorMessage tell why.
 //====================================================================
-void Graph::buildGraph (ifstream &infile)
+template <class W, class D>
+bool BasicGraph<W, D>::buildGraph (ifstream &infile)
 {
-	int cur, src, dest, cost;	
-	Object     *vertex_data;
-
-	if (infile.eof()) return;
+	int cur, size, length;	
+	StagedEdge edge;
+	vector<StagedEdge> staged;
+	const char *line, *end;
+	bool ok = true, ended = false, in_sync = true;
+
+	my_error_line    = 0;
+	my_error_message = "";
+	if (infile.eof()) return false;
+
+	// Start over if this graph was already built.
+	delete_vertices();
+	TextReader reader (infile);
 	
 	// GET SIZE 
-	infile >> my_size;	
-	infile.ignore(); // Throw away '\n'.			
-
-	// To many vertices.
-	if (my_size >= MAX_VERTICES) return;
+	do {
+		if (!reader.nextLine (line, length)) {
+			// Nothing but blank lines were left.
+			reader.finish();
+			return false;
+		}
+		end = line + length;
+	} while (TextReader::skipBlanks (line, end));
+
+	if (!TextReader::parseInt (line, end, size) || size < 1 ||
+	    !TextReader::skipBlanks (line, end)) {
+		set_error (reader.getLine(), "expected the number of vertices");
+		reader.finish();
+		return false;
+	}
+	resize_storage (size);
+	init_table();
 
 	// GET VERTEX DESCRIPTION
+	// Repeated descriptions are stored once. A missing one is
+	// left empty.
+	my_descriptions    = make_shared<StringPool> ();
+	my_description_ids = make_shared< vector<int> > (my_size + 1, 0);
+	vector<int> &ids   = *my_description_ids;
+	ids [0] = my_descriptions->intern ("", 0); // Not using index 0.
 	for (cur = 1; cur <= my_size; cur++) { 
-		vertex_data = new Object ();
-		vertex_data->setData (infile);
+		if (ok && reader.nextLine (line, length)) {
+			ids [cur] = my_descriptions->intern (line, length);
+		} else if (ok) {
+			set_error (reader.getLine() + 1, "missing vertex description");
+			ok = false;
+		}
 
 		// SET VERTEX DATA.  
-		my_vertices [cur].data = vertex_data;
 		my_vertices [cur].edgeHead = NULL; 
+		my_vertices [cur].reverseHead = NULL; 
 	}	
 
-	// FILL COST EDGE ARRAY	
-	for (;;) {
-		infile >> src >> dest >> cost;
-		if (src == 0 || infile.eof()) break;
-		insertEdge (src, dest, cost);	
+	// FILL STAGING BUFFER	
+	while (ok && reader.nextLine (line, length)) {
+		end = line + length;
+		if (TextReader::skipBlanks (line, end)) continue;
+
+		if (!TextReader::parseInt (line, end, edge.from)) {
+			set_error (reader.getLine(), "expected three integers");
+			in_sync = false;
+			break;
+		}
+		if (edge.from == 0) {
+			ended = true;
+			break;
+		}
+
+		if (!TextReader::parseInt (line, end, edge.to) ||
+		    !TextReader::parseInt (line, end, edge.weight)) {
+			set_error (reader.getLine(), "expected three integers");
+			in_sync = false;
+			break;
+		}
+		if (!TextReader::skipBlanks (line, end)) {
+			set_error (reader.getLine(), "unexpected text after the edge");
+			in_sync = false;
+			break;
+		}
+		// A well formed edge that can not be inserted is skipped,
+		// as insertEdge would refuse it, and the first one is 
+		// reported. The edges after it are still read.
+		if (!is_valid_edge (edge)) {
+			if (my_error_line != 0) continue;
+			if (edge.weight < 0)
+				set_error (reader.getLine(), "negative edge weight");
+			else if (edge.from < 1 || edge.from > my_size ||
+				 edge.to < 1 || edge.to > my_size)
+				set_error (reader.getLine(), "vertex out of range");
+			else
+				set_error (reader.getLine(), 
+					   "edge weight does not fit the weight type");
+			continue;
+		}
+		staged.push_back (edge);	
 	}	
+
+	// Skip the rest of the edges after a line that could not be 
+	// parsed, so the next graph in the stream can still be read.
+	if ((!ok || !in_sync) && !ended) {
+		while (reader.nextLine (line, length)) {
+			end = line + length;
+			if (TextReader::parseInt (line, end, edge.from) && 
+			    edge.from == 0) break;
+		}
+	}
+	reader.finish();
+
+	// Link every edge in at once, then do the shortest path
+	// work a single time. The graph is read-mostly from here on.
+	bulk_insert (staged);
+	compile();
+	if (!my_lazy) findShortestPath();
+	return my_error_line == 0;
+}
+
+
+//========================set_error===================================
+// Records the line number and message of a malformed line for 
+// errorLine and errorMessage.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::set_error (int the_line, const char *the_message)
+{
+	my_error_line    = the_line;
+	my_error_message = the_message;
+}
+
+
+//========================errorLine===================================
+// Returns the line number of the line that stopped the last 
+// buildGraph, or else of the first edge it skipped, counted from 
+// where it started reading, or zero if it had no error.
+//====================================================================
+template <class W, class D>
+int BasicGraph<W, D>::errorLine () const
+{
+	return my_error_line;
+}
+
+
+//========================errorMessage================================
+// Returns what was wrong with the line given by errorLine, or an 
+// empty string if the last buildGraph had no error.
+//====================================================================
+template <class W, class D>
+const char *BasicGraph<W, D>::errorMessage () const
+{
+	return my_error_message;
+}
+
+
+//========================bulk_insert=================================
+// Links the staged edges into the adjacency lists in one pass. The
+// result is the same as calling insertEdge on each edge in order,
+// without the duplicate scan or shortest path work per edge:
+//	- edges with out of range vertices or negative weights are
+//	  skipped.
+//	- a repeated edge keeps its first position and its last weight.
+//	- each list ends up newest edge first.
+//
+// The edges are bucketed by from vertex with a counting sort, and
+// duplicates are found with a per-vertex marker array, so the work 
+// is linear in the number of vertices and edges.
+// 
+// Preconditions: The vertices exist and have empty edge lists.
+//		
+// Postconditions: The adjacency lists, and the reverse lists, hold
+//		   the staged edges. The CSR arrays and table are not
+//		   updated.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::bulk_insert (const vector<StagedEdge> &the_edges)
+{
+	vector<int> start (my_size + 2, 0);
+	vector<int> order;
+	vector<int> marker (my_size + 1, 0);
+	vector<EdgeNode *> slot (my_size + 1, (EdgeNode *) NULL);
+	int i, vertex, last;
+	EdgeNode *edge_node;
+
+	// Count the valid edges of each from vertex.
+	for (i = 0; i < (int) the_edges.size(); i++) {
+		if (!is_valid_edge (the_edges [i])) continue;
+		start [the_edges [i].from + 1]++;
+		if ((W) the_edges [i].weight > my_max_weight)
+			my_max_weight = (W) the_edges [i].weight;
+	}
+	for (vertex = 1; vertex <= my_size; vertex++)
+		start [vertex + 1] += start [vertex];
+
+	// Make room for every edge and its reverse in one slab.
+	my_arena.reserve ((size_t) start [my_size + 1] * 2 * sizeof (EdgeNode));
+
+	// Bucket them by from vertex, keeping the file order.
+	order.resize (start [my_size + 1]);
+	for (i = 0; i < (int) the_edges.size(); i++) {
+		if (!is_valid_edge (the_edges [i])) continue;
+		order [start [the_edges [i].from]++] = i;
+	}
+
+	// Walk each bucket. start[vertex] is now the end of the 
+	// bucket, and the previous vertex's end is its beginning.
+	i = 0;
+	for (vertex = 1; vertex <= my_size; vertex++) {
+		last = start [vertex];
+		for (; i < last; i++) {
+			const StagedEdge &edge = the_edges [order [i]];
+
+			// A duplicate, update weight.
+			if (marker [edge.to] == vertex) {
+				slot [edge.to]->weight = (W) edge.weight;
+				continue;
+			}
+
+			// Not a duplicate, so link it in as our new head.
+			edge_node = new_edge (edge.to, edge.weight, 
+					      my_vertices [vertex].edgeHead);
+			my_vertices [vertex].edgeHead = edge_node;
+
+			marker [edge.to] = vertex;
+			slot [edge.to]   = edge_node;
+		}
+	}
+
+	// Mirror every edge into the reverse lists.
+	for (vertex = 1; vertex <= my_size; vertex++) {
+		for (edge_node = my_vertices [vertex].edgeHead; edge_node; 
+		     edge_node = edge_node->nextEdge)
+			link_reverse (vertex, edge_node->adjVertex, edge_node->weight);
+	}
+}
+
+
+//========================is_valid_edge===============================
+// Returns true if both vertices of the staged edge exist and its 
+// weight is not negative and a W holds it exactly.
+//====================================================================
+template <class W, class D>
+bool BasicGraph<W, D>::is_valid_edge (const StagedEdge &the_edge) const
+{
+	return the_edge.from >= 1 && the_edge.from <= my_size &&
+	       the_edge.to >= 1 && the_edge.to <= my_size &&
+	       the_edge.weight >= 0 && 
+	       (int) (W) the_edge.weight == the_edge.weight;
 }
 
 
 //========================insertEdge==================================
-// Inserts an edge into this graph. Inserting this edge must not
-// exceed the max of 100 edges. The first int is the from vertex, the
-// second is the to vertex, and the third int is the weight of the 
-// edge. 
+// Inserts an edge into this graph. The first int is the from vertex,
+// the second is the to vertex, and the W is the weight of the edge. 
 //
-// If an edge is inserted, the findShortestPath method is ran
-// to prevent a display of data that is not up to date.
+// If an edge is inserted, or an existing edge's weight changes, the
+// rows of the table that are already computed are repaired so no 
+// data that is not up to date is displayed.
 // 
-// Preconditions: The vertices must exist in the graph. Adding the
-//		  edge must not exceed the max edges of	100. 
+// Preconditions: The vertices must exist in the graph. 
 //		
 // Postconditions: Returns true if the edge was inserted into the
 //		   graph, false otherwise.
 //==================================================================== 
-bool Graph::insertEdge (int the_from_v, int the_to_v, int the_weight)
+template <class W, class D>
+bool BasicGraph<W, D>::insertEdge (int the_from_v, int the_to_v, W the_weight)
 {
-	EdgeNode *edge_node, *cur;
+	EdgeNode *edge_node;
+	W old_weight;
 
 	// Ensure vertices are within range, and non negative weight.
-	if (the_from_v < 1 || the_from_v > my_size || 
-		the_to_v < 1 || the_to_v > my_size || 
-			the_weight < 0) return false;		
+	// Written so a NaN weight is refused too.
+	if (the_from_v < 1 || the_from_v > my_size ||
+		the_to_v < 1 || the_to_v > my_size ||
+			!(the_weight >= 0)) return false;
+
+	// A mapped graph or snapshot is read-only, so make it a 
+	// normal one.
+	if (my_vertices.empty()) materialize();
+
+	// The lists use the internal vertices.
+	the_from_v = internal_id (the_from_v);
+	the_to_v   = internal_id (the_to_v);
+
+	if (the_weight > my_max_weight) my_max_weight = the_weight;
+
+	// First check for a duplicate.
+	edge_node = find_edge (my_vertices [the_from_v].edgeHead, the_to_v);
+	if (edge_node != NULL) {
+		// We have a duplicate, update weight in both lists.
+		old_weight = edge_node->weight;
+		edge_node->weight = the_weight;
+		find_edge (my_vertices [the_to_v].reverseHead,
+			   the_from_v)->weight = the_weight;
+
+		if (the_weight < old_weight)
+			edge_decreased (the_from_v, the_to_v, the_weight);
+		else if (the_weight > old_weight)
+			edge_increased (the_from_v, the_to_v);
+		return true;
+	}
 
-	// Setup the new edge.
-	edge_node            = new EdgeNode;
-	edge_node->weight    = the_weight;
-	edge_node->adjVertex = the_to_v;
+	// Not a duplicate, so link it in as our new head.
+	edge_node = new_edge (the_to_v, the_weight, my_vertices [the_from_v].edgeHead);
+	my_vertices [the_from_v].edgeHead = edge_node;
+	link_reverse (the_from_v, the_to_v, the_weight);
 
-	// Is it the first edge being added.
-	if (my_vertices [the_from_v].edgeHead == NULL) { 
-		// Link it in as our head.
-		edge_node->nextEdge = NULL;
-		my_vertices [the_from_v].edgeHead = edge_node;
-	}
-	
-	else {
-		// First check for a duplicate.
-		cur = my_vertices [the_from_v].edgeHead;
-		while (cur != NULL) {
-		 	if (cur->adjVertex == the_to_v) {
-				// We have a duplicate, update weight. 
-				cur->weight = the_weight;	
-				delete edge_node;
-				return true;		
-			} 	
-			cur = cur->nextEdge;	
-		}
-	
-		// Not a duplicate, so link it in as our new head.
-		edge_node->nextEdge = my_vertices [the_from_v].edgeHead;
-		my_vertices [the_from_v].edgeHead = edge_node;
-	} 
-		
-	// We inserted into the graph, 
+	// We inserted into the graph,
 	// now we have to update the table.
-	findShortestPath();
+	edge_decreased (the_from_v, the_to_v, the_weight);
 	return true;
 }
 
 
 //========================removeEdge==================================
 // Removes an edge from the graph. The first provided int is the from
-// vertex, and the second int is the to vertex. 
+// vertex, and the second int is the to vertex.
 //
-// 
-// If an edge is removed, the findShortestPath method is ran to
-// prevent a display of data that is not up to date.
+// If an edge is removed, the rows of the table that are already
+// computed are repaired so no data that is not up to date is
+// displayed.
 //
 // Preconditions: The edge must exist. The from vertex and to vertex
 //		  must exist.
-//		
+//
 // Postconditions: Returns true if the edge was removed, returns false
 //		   otherwise.
-//==================================================================== 
-bool Graph::removeEdge (int the_from_v, int the_to_v) 
+//====================================================================
+template <class W, class D>
+bool BasicGraph<W, D>::removeEdge (int the_from_v, int the_to_v)
 {
-	EdgeNode *cur, *prev;
+	EdgeNode *edge_node;
 
 	// Ensure vertices are within range.
-	if (the_from_v < 1 || the_from_v > my_size || 
-		the_to_v < 1 || the_to_v > my_size) return false;		
+	if (the_from_v < 1 || the_from_v > my_size ||
+		the_to_v < 1 || the_to_v > my_size) return false;
 
-	cur = prev = my_vertices [the_from_v].edgeHead; 	
-	while (cur != NULL) {
-		if (cur->adjVertex == the_to_v) {
-			// We found the edge, link prev to next.
-			prev->nextEdge = cur->nextEdge;	
-			delete cur;	
-			cur->nextEdge = NULL;
-			// We removed an edge, so we have to 
-			// update the table.
-			findShortestPath();
-			return true;			
-		}
-		prev = cur;
-		cur  = cur->nextEdge;	
-	} 
-	return false;
+	// A mapped graph or snapshot is read-only, so make it a 
+	// normal one.
+	if (my_vertices.empty()) materialize();
+
+	// The lists use the internal vertices.
+	the_from_v = internal_id (the_from_v);
+	the_to_v   = internal_id (the_to_v);
+
+	edge_node = unlink_edge (my_vertices [the_from_v].edgeHead, the_to_v);
+	if (edge_node == NULL) return false;
+	free_edge (edge_node);
+	free_edge (unlink_edge (my_vertices [the_to_v].reverseHead, the_from_v));
+
+	// We removed an edge, so we have to update the table.
+	edge_increased (the_from_v, the_to_v);
+	return true;
 }
 
 
-//========================findShortestPath============================
-// Finds the shortest path between all vertices in the graph.  
-// 
-// Preconditions: The graph is built.
-//		
-// Postconditions: The shortest paths between all the vertices have
-//		   been found. 
-//==================================================================== 
-void Graph::findShortestPath ()
-{	
-	int i;
-	init_table ();
-	for (i = 1; i <= my_size; i++)
-		run_dijkstra (i);
+//========================link_reverse================================
+// Adds the edge from the first int to the second int, with the given
+// weight, to the head of the second vertex's reverse list.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::link_reverse (int the_from_v, int the_to_v, W the_weight)
+{
+	my_vertices [the_to_v].reverseHead = 
+		new_edge (the_from_v, the_weight, my_vertices [the_to_v].reverseHead);
 }
 
 
-//========================run_dijkstra================================
-// Finds the shortest path for each of the vertices in the graph to
-// all the other vertices.
+//========================compile=====================================
+// Freezes the adjacency lists into compressed sparse row (CSR) form.
+// The edges of vertex v are stored at indices offsets[v] up to
+// offsets[v + 1] of targets and weights in my_csr, in the same order
+// as the linked list, so Dijkstra's algorithm can walk them linearly
+// instead of chasing nextEdge pointers.
 // 
-// Preconditions: The graph is built and init_table is needed
-//		  to initialize the table
-// 		  		
-// Postconditions: The shortest paths for each of the vertices
-//		   in the graph have been found.
-//==================================================================== 
-void Graph::run_dijkstra (int the_source) 
+// Preconditions: The graph is built.
+//		
+// Postconditions: The CSR arrays match the adjacency lists.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::compile ()
 {
-	// Used for traversing vertex edges.
+	int vertex, count;
 	EdgeNode *edge;
 
-	// The current vertex, current distance, and edge weight .
-	int vertex, distance, weight; 
-	int count;
-	count = my_size;
+	if (my_compiled) return;
+
+	// Never change arrays a copy or snapshot still reads.
+	if (!my_csr || my_csr.use_count() > 1)
+		my_csr = make_shared<CsrArrays> ();
+	vector<int> &offsets = my_csr->offsets;
+	vector<int> &targets = my_csr->targets;
+	vector<W> &weights = my_csr->weights;
+
+	// Count the edges of each vertex. Not using index 0, and
+	// one extra offset marks the end of the last vertex.
+	offsets.assign (my_size + 2, 0);
+	count = 0;
+	for (vertex = 1; vertex <= my_size; vertex++) {
+		offsets [vertex] = count;
+		for (edge = my_vertices[vertex].edgeHead; edge; edge = edge->nextEdge)
+			count++;
+	}
+	offsets [my_size + 1] = count;
+
+	// Lay the edges out contiguously.
+	targets.resize (count);
+	weights.resize (count);
+	for (vertex = 1; vertex <= my_size; vertex++) {
+		count = offsets [vertex];
+		for (edge = my_vertices[vertex].edgeHead; edge; edge = edge->nextEdge) {
+			targets [count] = edge->adjVertex;
+			weights [count] = edge->weight;
+			count++;
+		}
+	}
+	use_owned_csr();
+	my_compiled = true;
+	my_reverse_compiled = false;
+}
 
-	// Distance from source to source is zero.
-	my_table [the_source][the_source].distance    = 0;
-	my_table [the_source][the_source].prev_vertex = the_source; 
 
+//========================compile_reverse=============================
+// Compiles the graph if needed, then builds the reverse CSR arrays 
+// with a counting sort of the CSR arrays by target. The edges 
+// entering vertex v end up at my_in_offsets[v] up to 
+// my_in_offsets[v + 1] of my_in_sources and my_in_weights. Building
+// them from the CSR arrays also works for a mapped graph, which has 
+// no reverse lists.
+// 
+// Preconditions: The graph is built.
+//		
+// Postconditions: The reverse CSR arrays match the graph.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::compile_reverse ()
+{
+	int vertex, edge, edges, slot;
+
+	compile();
+	if (my_reverse_compiled) return;
+
+	// Count the edges entering each vertex, shifted by one so the
+	// running sum leaves the start of each vertex's run.
+	edges = (my_size > 0) ? my_out_offsets [my_size + 1] : 0;
+	my_in_offsets.assign (my_size + 2, 0);
+	for (edge = 0; edge < edges; edge++)
+		my_in_offsets [my_out_targets [edge] + 1]++;
+	for (vertex = 1; vertex <= my_size; vertex++)
+		my_in_offsets [vertex + 1] += my_in_offsets [vertex];
+
+	// Place each edge, using my_in_offsets[v] as v's next free slot
+	// and shifting it back afterwards.
+	my_in_sources.resize (edges);
+	my_in_weights.resize (edges);
+	for (vertex = 1; vertex <= my_size; vertex++) {
+		for (edge = my_out_offsets [vertex]; edge < my_out_offsets [vertex + 1]; edge++) {
+			slot = my_in_offsets [my_out_targets [edge]]++;
+			my_in_sources [slot] = vertex;
+			my_in_weights [slot] = my_out_weights [edge];
+		}
+	}
+	for (vertex = my_size; vertex >= 1; vertex--)
+		my_in_offsets [vertex] = my_in_offsets [vertex - 1];
+	my_in_offsets [0] = 0;
+	my_reverse_compiled = true;
+}
 
-	while (count > 0) {
-		// Get the vertex associated with the shortest distance. 	
-		vertex = find_and_visit_minimum (the_source);
-		if (vertex == -1) break;		
 
-		// Get the first edge of the vertex.
-		edge = my_vertices[vertex].edgeHead;	
+//========================use_owned_csr===============================
+// Points the CSR views the Dijkstra kernels read (my_out_offsets,
+// my_out_targets and my_out_weights) at my_csr.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::use_owned_csr ()
+{
+	my_out_offsets = (!my_csr || my_csr->offsets.empty()) ? NULL : &my_csr->offsets [0];
+	my_out_targets = (!my_csr || my_csr->targets.empty()) ? NULL : &my_csr->targets [0];
+	my_out_weights = (!my_csr || my_csr->weights.empty()) ? NULL : &my_csr->weights [0];
+}
 
-		while (edge) {	
-			
-			// If the shortest path to the adjacent vertex hasn't been found. 	
-			if (!my_table[the_source][edge->adjVertex].isVisited) {
 
-				// Get the weight of the edge. 	
-				weight = edge->weight;
-	
-				// If this is the fist time adding a distance to this vertex.	
-				if (my_table[the_source][edge->adjVertex].distance == -1) {
-					my_table[the_source][edge->adjVertex].distance = 
-						weight + my_table[the_source][vertex].distance;
-						// It's shortest path has been updated.
-						my_table[the_source][edge->adjVertex].prev_vertex = vertex; 
-				}
-				
-				else { // Otherwise, get the distance and compare it to its' current.
-					distance = weight + my_table[the_source][vertex].distance;
-					// If the new distance is shorter than the current, update it.	
-					if (distance < my_table[the_source][edge->adjVertex].distance) {
-						my_table[the_source][edge->adjVertex].distance = distance;
-						// It's shortest path has been updated.
-						my_table[the_source][edge->adjVertex].prev_vertex = vertex;
-					}
-				} 
-			} 
-			// Now move to the next edge. 
-			edge = edge->nextEdge;
-		} // end while(edge) 
-		count--;
-	} // end while (count > 0)	
+//========================isCompiled==================================
+// Returns true if the CSR arrays match the adjacency lists.
+//====================================================================
+template <class W, class D>
+bool BasicGraph<W, D>::isCompiled () const
+{
+	return my_compiled;
 }
 
 
-//========================find_and_vist_minimum=======================
-// Finds and returns the vertex with the minimum distance from the 
-// vertices that have not yet been visited within my_table
+//========================reorder=====================================
+// Renumbers the vertices internally in the given order, so vertices
+// near each other in the graph are near each other in the CSR arrays
+// and the rows of the table. Input files often number vertices in no
+// useful order, and then every relaxation of Dijkstra's algorithm 
+// reads a distance on a different cache line. BFS_ORDER and 
+// RCM_ORDER give each vertex numbers close to its neighbours', and
+// DEGREE_ORDER packs the busiest vertices together.
 //
-// It then marks the returned vertex as being visisted.
-//
-// Preconditions:  my_table needs to have all vertices that have not
-//		   been visisted set to false. The distance of each 
-//		   vertex in my_table need to be set to -1 if a
-//		   distance has not yet been assigned. the_source
-//		   needs to be a valid index of my_table.
-//		    	  		  		
-// Postconditions: Returns the vertex with the shortest distance 
-//		   from the vertex that has not yet been visited.
-//==================================================================== 
-int Graph::find_and_visit_minimum (int the_source)
+// Only the internal vertices change. The numbers from the input are
+// kept in my_external_ids and my_internal_ids, and the public methods
+// translate at their boundary, so callers and the output see no 
+// difference.
+// 
+// Preconditions: The graph is built.
+//		
+// Postconditions: The graph is unchanged except for where its 
+//		   vertices are stored. The table is cleared, and in
+//		   eager mode filled again.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::reorder (Ordering the_ordering)
+{
+	vector<int> order;
+
+	if (my_size == 0) return;
+
+	// A mapped graph or snapshot has no lists to move, so make it
+	// a normal one.
+	if (my_vertices.empty()) materialize();
+
+	compile_reverse();
+	order_vertices (the_ordering, order);
+	relabel (order);
+
+	// Everything built from the old order is stale.
+	my_compiled         = false;
+	my_reverse_compiled = false;
+	init_table();
+	compile();
+	if (!my_lazy) findShortestPath();
+}
+
+
+//========================isReordered=================================
+// Returns true if reorder has renumbered the vertices.
+//====================================================================
+template <class W, class D>
+bool BasicGraph<W, D>::isReordered () const
+{
+	return !my_external_ids.empty();
+}
+
+
+//========================internal_id=================================
+// Returns the internal vertex of the given number from the input.
+//====================================================================
+template <class W, class D>
+inline int BasicGraph<W, D>::internal_id (int the_vertex) const
+{
+	return my_internal_ids.empty() ? the_vertex : my_internal_ids [the_vertex];
+}
+
+
+//========================external_id=================================
+// Returns the number from the input of the given internal vertex.
+//====================================================================
+template <class W, class D>
+inline int BasicGraph<W, D>::external_id (int the_vertex) const
+{
+	return my_external_ids.empty() ? the_vertex : my_external_ids [the_vertex];
+}
+
+
+//========================to_external=================================
+// Replaces every internal vertex in the vector with its number from
+// the input.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::to_external (vector<int> &the_vertices) const
 {
 	int i;
-	int distance;
+
+	if (my_external_ids.empty()) return;
+	for (i = 0; i < (int) the_vertices.size(); i++)
+		the_vertices [i] = my_external_ids [the_vertices [i]];
+}
+
+
+//========================order_vertices==============================
+// Sets the vector to the internal vertices in the given order, not 
+// using index 0. The edges are treated as undirected, counting the
+// ones leaving and entering a vertex for its degree.
+//
+// BFS_ORDER and RCM_ORDER run a breadth first search from each 
+// vertex not reached yet, and number the vertices in the order they
+// are reached. BFS_ORDER starts from the lowest number and takes the
+// neighbours in the order of the CSR arrays. RCM_ORDER starts from
+// the lowest degree and takes the neighbours in order of degree, and
+// the order is reversed at the end, which for sparse graphs keeps the
+// edges closer to the diagonal. DEGREE_ORDER sorts the vertices by
+// degree, highest first.
+//
+// Vertices are sorted by degree through keys holding the degree in 
+// the high 32 bits and the vertex in the low ones, so ties keep the
+// vertices in order.
+// 
+// Preconditions: The reverse CSR arrays are compiled.
+//		
+// Postconditions: The vector holds every vertex once.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::order_vertices (Ordering the_ordering, 
+				       vector<int> &the_order)
+{
+	vector<int> degree (my_size + 1, 0);
+	vector<long long> keys (my_size);
+	vector<long long> reached;
+	vector<bool> placed (my_size + 1, false);
+	int vertex, adjacent, head, edge, i, j;
+
+	for (vertex = 1; vertex <= my_size; vertex++) {
+		degree [vertex] = my_out_offsets [vertex + 1] - my_out_offsets [vertex] +
+				  my_in_offsets [vertex + 1] - my_in_offsets [vertex];
+	}
+
+	// The vertices in the order the searches start from, or the 
+	// final order for DEGREE_ORDER.
+	for (vertex = 1; vertex <= my_size; vertex++) {
+		if (the_ordering == BFS_ORDER)
+			keys [vertex - 1] = vertex;
+		else if (the_ordering == RCM_ORDER)
+			keys [vertex - 1] = ((long long) degree [vertex] << 32) | vertex;
+		else
+			keys [vertex - 1] = ((long long) (INT_MAX - degree [vertex]) << 32) | vertex;
+	}
+	if (the_ordering != BFS_ORDER) sort (keys.begin(), keys.end());
+
+	the_order.assign (1, 0); // Not using index 0.
+	if (the_ordering == DEGREE_ORDER) {
+		for (i = 0; i < my_size; i++)
+			the_order.push_back ((int) (keys [i] & 0xffffffffLL));
+		return;
+	}
+
+	for (i = 0; i < my_size; i++) {
+		vertex = (int) (keys [i] & 0xffffffffLL);
+		if (placed [vertex]) continue;
+		placed [vertex] = true;
+		the_order.push_back (vertex);
+
+		// A vertex is placed when it is first reached, so it is
+		// queued once.
+		for (head = (int) the_order.size() - 1; head < (int) the_order.size(); head++) {
+			vertex = the_order [head];
+			reached.clear();
+			for (edge = my_out_offsets [vertex]; edge < my_out_offsets [vertex + 1]; edge++) {
+				adjacent = my_out_targets [edge];
+				if (placed [adjacent]) continue;
+				placed [adjacent] = true;
+				reached.push_back (((long long) degree [adjacent] << 32) | adjacent);
+			}
+			for (edge = my_in_offsets [vertex]; edge < my_in_offsets [vertex + 1]; edge++) {
+				adjacent = my_in_sources [edge];
+				if (placed [adjacent]) continue;
+				placed [adjacent] = true;
+				reached.push_back (((long long) degree [adjacent] << 32) | adjacent);
+			}
+			if (the_ordering == RCM_ORDER) sort (reached.begin(), reached.end());
+			for (j = 0; j < (int) reached.size(); j++)
+				the_order.push_back ((int) (reached [j] & 0xffffffffLL));
+		}
+	}
+	if (the_ordering == RCM_ORDER) reverse (the_order.begin() + 1, the_order.end());
+}
+
+
+//========================relabel=====================================
+// Moves the vertex at index i of the vector to internal vertex i. The
+// VertexNodes move as they are, with their lists and descriptions, 
+// and the end of every edge in the lists is renamed. The descriptions
+// are renamed the same way, in a new vector, since copies and 
+// snapshots may share the old one.
+// my_external_ids is built through the old one, so reordering again
+// still maps to the numbers from the input.
+// 
+// Preconditions: The graph has its adjacency lists, and the vector 
+//		  holds every vertex once.
+//		
+// Postconditions: The lists use the new numbers. The CSR arrays and
+//		   table are stale.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::relabel (const vector<int> &the_order)
+{
+	vector<VertexNode> vertices (my_size + 1);
+	vector<int> position (my_size + 1, 0);
+	vector<int> external (my_size + 1, 0);
+	shared_ptr< vector<int> > ids = make_shared< vector<int> > (my_size + 1, 0);
+	EdgeNode *edge;
 	int vertex;
-	vertex   = 0;
-	distance = INT_MAX;
-
-	for (i = 1; i <= my_size; i++) {
-		// If it's not visited, and has a distance already 
-		// assigned, and its distance is shorter than 
-		// the current distance we have stored.
-		if (!my_table[the_source][i].isVisited && 
-		    my_table[the_source][i].distance != -1 &&
-		    my_table[the_source][i].distance < distance) {
-			distance = my_table[the_source][i].distance;
-			vertex = i;
+
+	for (vertex = 1; vertex <= my_size; vertex++)
+		position [the_order [vertex]] = vertex;
+
+	for (vertex = 1; vertex <= my_size; vertex++) {
+		vertices [vertex] = my_vertices [the_order [vertex]];
+		external [vertex] = external_id (the_order [vertex]);
+		(*ids) [vertex]   = (*my_description_ids) [the_order [vertex]];
+		for (edge = vertices [vertex].edgeHead; edge; edge = edge->nextEdge)
+			edge->adjVertex = position [edge->adjVertex];
+		for (edge = vertices [vertex].reverseHead; edge; edge = edge->nextEdge)
+			edge->adjVertex = position [edge->adjVertex];
+	}
+	my_vertices.swap (vertices);
+	my_description_ids = ids;
+
+	my_external_ids.swap (external);
+	my_internal_ids.assign (my_size + 1, 0);
+	for (vertex = 1; vertex <= my_size; vertex++)
+		my_internal_ids [my_external_ids [vertex]] = vertex;
+}
+
+
+//========================edge_decreased==============================
+// Called after the edge from the first int to the second int was
+// inserted, or had its weight lowered to the given one. Marks the CSR
+// arrays stale and repairs every computed row of the table.
+//
+// Only the rows where the edge gives a shorter path change, and only
+// the vertices whose distance drops are visited, so this is much
+// cheaper than running findShortestPath again.
+//
+// Preconditions: The adjacency lists hold the new edge.
+//
+// Postconditions: No stale distance can be displayed.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::edge_decreased (int the_from_v, int the_to_v, W the_weight)
+{
+	int source;
+
+	my_compiled = false;
+	if (needs_full_update()) return;
+
+	for (source = 1; source <= my_size; source++) {
+		if (!my_table [source].distance.empty())
+			repair_decrease (source, the_from_v, the_to_v, the_weight);
+	}
+}
+
+
+//========================edge_increased==============================
+// Called after the edge from the first int to the second int was
+// removed, or had its weight raised. Marks the CSR arrays stale and
+// repairs every computed row of the table.
+//
+// Only rows whose shortest path tree used the edge change, and only
+// the subtree hanging below it is recomputed.
+//
+// Preconditions: The adjacency lists no longer hold the old edge.
+//
+// Postconditions: No stale distance can be displayed.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::edge_increased (int the_from_v, int the_to_v)
+{
+	int source;
+
+	my_compiled = false;
+	if (needs_full_update()) return;
+
+	for (source = 1; source <= my_size; source++) {
+		if (!my_table [source].distance.empty())
+			repair_increase (source, the_from_v, the_to_v);
+	}
+}
+
+
+//========================needs_full_update===========================
+// In eager mode every row must be up to date after a change. If some
+// rows were never computed there is nothing to repair them from, so
+// findShortestPath is run instead and true is returned.
+//====================================================================
+template <class W, class D>
+bool BasicGraph<W, D>::needs_full_update ()
+{
+	if (my_lazy || my_rows_computed == my_size) return false;
+	findShortestPath();
+	return true;
+}
+
+
+//========================repair_decrease=============================
+// Repairs the row of the given source after the edge from the second
+// int to the third int got the given (lower) weight. If
+// the edge gives the third vertex a shorter path, the improvement is
+// pushed outwards with propagate.
+//
+// Preconditions: The row for the source is computed and was correct
+//		  before the change.
+//
+// Postconditions: The row for the source is correct.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::repair_decrease (int the_source, int the_from_v,
+			     int the_to_v, W the_weight)
+{
+	Row &row = my_table [the_source];
+	D distance;
+
+	// The edge can not be used if its start can not be reached.
+	if (row.distance [the_from_v] == INFINITE) return;
+
+	distance = add_weight (row.distance [the_from_v], the_weight);
+	if (distance >= row.distance [the_to_v]) return;
+
+	my_heap.reset (my_size);
+	row.distance [the_to_v]    = distance;
+	row.prev_vertex [the_to_v] = the_from_v;
+	row.visited [the_to_v]     = true;
+	my_heap.push (the_to_v, distance);
+	propagate (the_source);
+}
+
+
+//========================repair_increase=============================
+// Repairs the row of the given source after the edge from the second
+// int to the third int was removed or made heavier.
+//
+// If the edge is in the source's shortest path tree, every vertex in
+// the subtree below it loses its distance. Each of them then takes
+// the best path through an in-edge from a vertex outside the
+// subtree, and propagate settles the rest of the subtree from there.
+//
+// Preconditions: The row for the source is computed and was correct
+//		  before the change.
+//
+// Postconditions: The row for the source is correct.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::repair_increase (int the_source, int the_from_v, int the_to_v)
+{
+	Row &row = my_table [the_source];
+	vector<int> start;
+	vector<int> children;
+	vector<int> subtree;
+	vector<bool> in_subtree;
+	EdgeNode *edge;
+	int vertex, child, parent, i;
+	D distance;
+
+	// The tree did not use the edge, nothing changed.
+	if (the_to_v == the_source || row.prev_vertex [the_to_v] != the_from_v)
+		return;
+
+	// List the children of each vertex in the tree, with a
+	// counting sort on the previous vertex. The children of v
+	// end up at indices start[v] up to start[v + 1].
+	start.assign (my_size + 2, 0);
+	children.resize (my_size);
+	for (vertex = 1; vertex <= my_size; vertex++) {
+		parent = row.prev_vertex [vertex];
+		if (parent != 0 && vertex != the_source) start [parent]++;
+	}
+	for (vertex = 1; vertex <= my_size + 1; vertex++)
+		start [vertex] += start [vertex - 1];
+	for (vertex = my_size; vertex >= 1; vertex--) {
+		parent = row.prev_vertex [vertex];
+		if (parent != 0 && vertex != the_source)
+			children [--start [parent]] = vertex;
+	}
+
+	// Collect the subtree below the edge.
+	in_subtree.assign (my_size + 1, false);
+	subtree.push_back (the_to_v);
+	in_subtree [the_to_v] = true;
+	for (i = 0; i < (int) subtree.size(); i++) {
+		vertex = subtree [i];
+		for (child = start [vertex]; child < start [vertex + 1]; child++) {
+			subtree.push_back (children [child]);
+			in_subtree [children [child]] = true;
 		}
 	}
 
-	if (vertex == 0) {
-		return -1;
-	}  else  {
-		my_table[the_source][vertex].isVisited = true; 
-		return vertex; 
+	// Forget their paths.
+	for (i = 0; i < (int) subtree.size(); i++) {
+		vertex = subtree [i];
+		row.distance [vertex]    = INFINITE;
+		row.prev_vertex [vertex] = 0;
+		row.visited [vertex]     = false;
+	}
+
+	// Reconnect each vertex through its best in-edge from outside.
+	my_heap.reset (my_size);
+	for (i = 0; i < (int) subtree.size(); i++) {
+		vertex = subtree [i];
+		for (edge = my_vertices [vertex].reverseHead; edge; edge = edge->nextEdge) {
+			parent = edge->adjVertex;
+			if (in_subtree [parent] || row.distance [parent] == INFINITE) continue;
+			distance = add_weight (row.distance [parent], edge->weight);
+			if (distance < row.distance [vertex]) {
+				row.distance [vertex]    = distance;
+				row.prev_vertex [vertex] = parent;
+			}
+		}
+		if (row.distance [vertex] != INFINITE) {
+			row.visited [vertex] = true;
+			my_heap.push (vertex, row.distance [vertex]);
+		}
 	}
+	propagate (the_source);
 }
 
 
-//========================displayAll==================================
-// Displays the entire graph. Prints out the vertices description, the
-// edges associated with the vertices, and the edge weights. 
+//========================propagate===================================
+// Settles the vertices in my_heap in order of distance, relaxing the
+// edges leaving each one. This is Dijkstra's algorithm restricted to
+// the vertices whose distance has just dropped, so the rest of the
+// row is left alone.
+//
+// Preconditions: my_heap holds the vertices whose distance dropped,
+//		  keyed by their new distance.
+//
+// Postconditions: The row for the source is correct.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::propagate (int the_source)
+{
+	Row &row = my_table [the_source];
+	EdgeNode *edge;
+	int vertex, adjacent;
+	D distance;
+
+	while (!my_heap.isEmpty()) {
+		vertex = my_heap.pop();
+		for (edge = my_vertices [vertex].edgeHead; edge; edge = edge->nextEdge) {
+			adjacent = edge->adjVertex;
+			distance = add_weight (row.distance [vertex], edge->weight);
+			if (distance >= row.distance [adjacent]) continue;
+
+			row.distance [adjacent]    = distance;
+			row.prev_vertex [adjacent] = vertex;
+			row.visited [adjacent]     = true;
+			if (my_heap.contains (adjacent))
+				my_heap.decreaseKey (adjacent, distance);
+			else
+				my_heap.push (adjacent, distance);
+		}
+	}
+}
+
+
+//========================ensure_row==================================
+// Runs Dijkstra's algorithm from the given source vertex if its row
+// of the table is not up to date.
 // 
-// Preconditions: The graph must have already built. 
+// Preconditions: The given vertex exists.
 //		
-// Postconditions: A detailed graph is desplayed showing all the 
-//		   vertices, the edges, and weights. 
-//==================================================================== 
-void Graph::displayAll ()
+// Postconditions: The row for the given source is up to date.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::ensure_row (int the_source)
 {
-	int row, col;
+	if (!my_table [the_source].distance.empty()) return;
+	compile();
+	run_dijkstra (the_source);
+}
 
-	// Display the boarder.
-	cout << setw(56) << setfill('-') << '|' << endl;
-	
-	// Display the table column headers. 
-	cout << setfill(' ') << "Description" << setw(15)
-	     << "From"     << setw(5)      << "To"          << setw(11) 
-	     << "Distance" << setw(7)      << "Path"        << endl;  
-	
-	// Go through each row of the table.
-	for (row = 1; row <= my_size; row++) { 
 
-		// Display vertex description. 
-		cout << *my_vertices [row].data << endl; 
-		
-		// Go through each column of the table. 
-		for (col = 1; col <= my_size; col++) {
-			if (col != row) {
-				// Display the *from* vertex.  
-				cout << setw(23) << row; 
-
-				// Display the *to* vertex.
-				cout << setw(7);
-				cout << col; 
-			
-				// Display the distance.
-				// First check if there is a path.
-				if (my_table[row][col].distance == -1) {
-					cout << setw(7);
-					cout << "--" << endl;		
-				} 
-					
-				else {
-					cout << setw(7);
-					cout << my_table[row][col].distance;
-					// Display the path recursively.
-					cout << setw(9); 
-					//display_helper(1, col, col);
-					display_helper (row, col, col);
-					cout << endl;
-				}
-			}			
-		} 
+//========================findShortestPath============================
+// Finds the shortest path between all vertices in the graph.  
+// 
+// Preconditions: The graph is built.
+//		
+// Postconditions: The shortest paths between all the vertices have
+//		   been found. 
+//==================================================================== 
+template <class W, class D>
+void BasicGraph<W, D>::findShortestPath ()
+{	
+	int i;
+	compile ();
+	init_table ();
+	if (my_threads > 1 && my_size > 1) {
+		run_parallel ();
+		return;
 	}
+	for (i = 1; i <= my_size; i++)
+		run_dijkstra (i);
 }
 
 
-//========================display=====================================
-// Displays the path from the first int to the second int. The ints
-// represents vertices in the graph, so they must exist. Prins out the
-// vertices description, the edges associated with the vertices, and
-// the edge weights. 
+//========================run_parallel================================
+// Runs Dijkstra's algorithm from every source on my_threads worker
+// threads. The sources are split into one block per worker, and a
+// worker that runs out steals from the busiest one, so a few slow
+// sources do not leave the other cores idle.
+//
+// Every worker has its own heap, and writes only to the rows of the
+// sources it takes, so no mutable state is shared between them.
 // 
-// Preconditions: The provided vertices must exist.
+// Preconditions: The CSR arrays are compiled and init_table has 
+//		  sized the table.
 //		
-// Postconditions: A detailed graph is displayed showing all the 
-//		   vertices, their description, edges, and weights. 
-//==================================================================== 
-void Graph::display(int the_start_v, int the_finish_v)
+// Postconditions: Every row of the table has been computed.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::run_parallel ()
 {
-	// Check valid range.
-	if (the_start_v < 1 || the_start_v > my_size ||
-	 	the_finish_v < 1 || the_finish_v > my_size) {
-			return;
-	}
+	int worker, threads;
+	vector<thread> workers;
 
-	// Check if the path exists.
-	if (my_table[the_start_v][the_finish_v].distance == -1) 
-		return;	
+	// The workers only read it.
+	if (!my_max_weight_known) find_max_weight();
 
-	// Display start vertex.	
-	cout << the_start_v;
-	
-	// Display end vertex.
-	cout << setw(7) << the_finish_v;
+	threads = (my_threads < my_size) ? my_threads : my_size;
+	Scheduler scheduler (threads, 1, my_size);
 
-	// Display distance.
-	cout << setw(7) << my_table[the_start_v]
-				   [the_finish_v].distance;
+	for (worker = 1; worker < threads; worker++)
+		workers.push_back (thread (&BasicGraph::run_worker, this, 
+					   ref (scheduler), worker));
 
-	// Print path recursively.
-	cout << setw(9); 
-	display_helper (the_start_v, the_finish_v, the_finish_v);
-	cout << endl;
-	print_vertices(the_start_v, the_finish_v, the_finish_v);
-	cout << endl;
-} 
+	// This thread is worker zero.
+	run_worker (scheduler, 0);
 
-	
-//========================display_helper==============================
-// A recursive helper method for displaying shortest paths.
+	for (worker = 0; worker < (int) workers.size(); worker++)
+		workers [worker].join();
+	my_rows_computed = my_size;
+}
+
+
+//========================run_worker==================================
+// The body of one worker thread of run_parallel. Takes sources from
+// the scheduler until there are none left.
 // 
-// Preconditions:  my_table is up to date. Otherwise the path might 
-//		   not print correctly. 
-// 		  		
-// Postconditions: The shortest path from the_source to the_last has
-//		   been printed to the output stream. 
-//==================================================================== 
-void Graph::display_helper (int the_source, int current, int the_last)
+// Preconditions: Same as run_parallel.
+//		
+// Postconditions: The rows of every source taken are computed.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::run_worker (Scheduler &the_scheduler, int the_worker)
 {
-	int vertex; 
-	if (current == the_source) {
-		cout << the_source;
-	 	return;
+	BasicHeap<D> heap (my_heap.getArity());
+	BasicBucketQueue<QueueKey> buckets;
+	BasicRadixHeap<QueueKey> radix;
+	int source;
+
+	while (the_scheduler.next (the_worker, source)) {
+		reset_row (source);
+		solve_row (source, heap, buckets, radix);
 	}
+}
+
 
-	vertex = my_table[the_source][current].prev_vertex;
-	display_helper (the_source, vertex, the_last); 
-	cout << " " << current;
+//========================run_dijkstra================================
+// Finds the shortest path from the given source vertex to all the
+// other vertices using the selected strategy. The source's row of 
+// the table is initialized first.
+// 
+// Preconditions: The graph is built and init_table is needed
+//		  to size the table
+// 		  		
+// Postconditions: The shortest paths for each of the vertices
+//		   in the graph have been found.
+//==================================================================== 
+template <class W, class D>
+void BasicGraph<W, D>::run_dijkstra (int the_source) 
+{
+	if (!my_max_weight_known) find_max_weight();
+	init_row (the_source);
+	solve_row (the_source, my_heap, my_buckets, my_radix);
 }
 
 
-//========================print_vertices==============================
-// A helper method for displaying the descriptions of	
-// vertices.
+//========================find_max_weight=============================
+// Sets my_max_weight to the largest weight in the CSR arrays. Only a
+// graph opened with openBinary needs this, and only once.
 // 
-// Preconditions: my_table is up to data.
-//		  		  		
-// Postconditions: The descriptions are printed to output.
+// Preconditions: The CSR arrays are compiled.
+//		
+// Postconditions: my_max_weight is known.
 //====================================================================
-void Graph::print_vertices (int the_source, int current, int the_last) {
-	int vertex; 
-	if (current == the_source) {
-		cout << *my_vertices[current].data;
-	 	return;
+template <class W, class D>
+void BasicGraph<W, D>::find_max_weight ()
+{
+	int edge;
+
+	my_max_weight = 0;
+	for (edge = 0; edge < my_out_offsets [my_size + 1]; edge++) {
+		if (my_out_weights [edge] > my_max_weight)
+			my_max_weight = my_out_weights [edge];
 	}
-	
-	vertex = my_table[the_source][current].prev_vertex;
-	print_vertices (the_source, vertex, the_last); 
-	cout << endl <<  *my_vertices[current].data;
+	my_max_weight_known = true;
+}
+
+
+//========================solve_row===================================
+// Runs the kernel for the selected strategy from the given source,
+// using the given queue of that strategy as scratch space. AUTO runs
+// the linear scan on a dense graph. Otherwise it runs the bucket 
+// queue if the largest weight is at most DIAL_LIMIT, since the 
+// buckets to walk are then few and small, and the radix heap if not.
+// On graphs too big for the cache both beat the d-ary heap, as 
+// their push and pop are a few steps instead of log V sift steps.
+// An explicit DIAL also runs the radix heap past DIAL_LIMIT, since
+// the bucket queue needs a bucket per weight, in every worker.
+// Both need whole number distances, so a graph with floating point
+// distances runs the heap instead.
+// 
+// Preconditions: The source's row has been initialized.
+// 		  		
+// Postconditions: The source's row holds its shortest paths.
+//==================================================================== 
+template <class W, class D>
+void BasicGraph<W, D>::solve_row (int the_source, BasicHeap<D> &the_heap, 
+				  BasicBucketQueue<QueueKey> &the_buckets,
+				  BasicRadixHeap<QueueKey> &the_radix) 
+{
+	Strategy strategy = my_strategy;
+
+	if (strategy == AUTO) {
+		if (is_dense())
+			strategy = LINEAR_SCAN;
+		else if (my_max_weight <= DIAL_LIMIT)
+			strategy = DIAL;
+		else
+			strategy = RADIX;
+	}
+	if (strategy == DIAL && my_max_weight > DIAL_LIMIT)
+		strategy = RADIX;
+	if ((strategy == DIAL || strategy == RADIX) && 
+	    !numeric_limits<D>::is_integer)
+		strategy = HEAP;
+
+	switch (strategy) {
+	case HEAP:
+		run_heap_dijkstra (the_source, the_heap);
+		break;
+	case DIAL:
+		the_buckets.reset ((int) my_max_weight);
+		run_monotone_dijkstra (the_source, the_buckets);
+		break;
+	case RADIX:
+		the_radix.reset();
+		run_monotone_dijkstra (the_source, the_radix);
+		break;
+	default:
+		run_linear_dijkstra (the_source);
+		break;
+	}
+}
+
+
+//========================run_linear_dijkstra=========================
+// Dijkstra's algorithm using find_and_visit_minimum to scan for the
+// next vertex. O(V^2) per source.
+// 
+// Preconditions: The graph is built and init_row is needed
+//		  to initialize the source's row.
+// 		  		
+// Postconditions: The shortest paths for each of the vertices
+//		   in the graph have been found.
+//==================================================================== 
+template <class W, class D>
+void BasicGraph<W, D>::run_linear_dijkstra (int the_source) 
+{
+	// Used for traversing the vertex's run of the CSR arrays.
+	int edge, last;
+
+	// The current vertex, adjacent vertex, current distance, 
+	// and edge weight.
+	int vertex, adjacent; 
+	D distance;
+	W weight;
+	int count;
+	count = my_size;
+
+	// The row's arrays, each read only where it is needed.
+	D *distances  = &my_table [the_source].distance [0];
+	int *previous = &my_table [the_source].prev_vertex [0];
+
+	// The distances of the vertices not visited yet, INFINITE for
+	// the rest, so the minimum scan reads this one array only.
+	vector<D> keys (my_size + 1, INFINITE);
+
+	// Distance from source to source is zero.
+	distances [the_source] = 0;
+	previous [the_source]  = the_source; 
+	keys [the_source]      = 0;
+
+
+	while (count > 0) {
+		// Get the vertex associated with the shortest distance. 	
+		vertex = find_and_visit_minimum (the_source, keys);
+		if (vertex == -1) break;		
+
+		// The edges of the vertex are contiguous in the CSR arrays.
+		last = my_out_offsets[vertex + 1];
+
+		for (edge = my_out_offsets[vertex]; edge < last; edge++) {	
+			adjacent = my_out_targets[edge];
+
+			// Get the weight of the edge. 	
+			weight = my_out_weights[edge];
+
+			// An unreached vertex is INFINITE, so the first
+			// distance found is always shorter. A visited one 
+			// is no farther than this vertex, and weights are
+			// not negative, so it is never shorter, and its 
+			// visited bit does not have to be read.
+			distance = add_weight (distances [vertex], weight);
+			if (distance < distances [adjacent]) {
+				distances [adjacent] = distance;
+				keys [adjacent]      = distance;
+				// It's shortest path has been updated.
+				previous [adjacent] = vertex;
+			}
+		} // end for (edge) 
+		count--;
+	} // end while (count > 0)	
+}
+
+
+//========================run_heap_dijkstra===========================
+// Dijkstra's algorithm using the given heap to pick the next vertex.
+// Each vertex is pushed once and its key lowered in place when a 
+// shorter distance is found. O((V+E) log V) per source.
+// 
+// Preconditions: The graph is built and init_row is needed
+//		  to initialize the source's row.
+// 		  		
+// Postconditions: The shortest paths for each of the vertices
+//		   in the graph have been found.
+//==================================================================== 
+template <class W, class D>
+void BasicGraph<W, D>::run_heap_dijkstra (int the_source, BasicHeap<D> &the_heap) 
+{
+	// Used for traversing the vertex's run of the CSR arrays.
+	int edge, last;
+
+	// The current vertex, its adjacent vertex, and the new distance.
+	int vertex, adjacent;
+	D distance;
+
+	// The row's arrays, each read only where it is needed.
+	D *distances  = &my_table [the_source].distance [0];
+	int *previous = &my_table [the_source].prev_vertex [0];
+	vector<bool> &visited = my_table [the_source].visited;
+
+	the_heap.reset (my_size);
+
+	// Distance from source to source is zero.
+	distances [the_source] = 0;
+	previous [the_source]  = the_source; 
+	the_heap.push (the_source, 0);
+
+	while (!the_heap.isEmpty()) {
+		// Get the vertex associated with the shortest distance.
+		vertex = the_heap.pop();
+		visited [vertex] = true;
+
+		last = my_out_offsets[vertex + 1];
+		for (edge = my_out_offsets[vertex]; edge < last; edge++) {
+			adjacent = my_out_targets[edge];
+
+			// The shortest path to it has already been found.
+			if (visited [adjacent]) continue;
+
+			distance = add_weight (distances [vertex], my_out_weights[edge]);
+
+			// If this is the first time adding a distance to this vertex.
+			if (distances [adjacent] == INFINITE) {
+				distances [adjacent] = distance;
+				previous [adjacent]  = vertex;
+				the_heap.push (adjacent, distance);
+			}
+
+			// Otherwise only update it if the new distance is shorter.
+			else if (distance < distances [adjacent]) {
+				distances [adjacent] = distance;
+				previous [adjacent]  = vertex;
+				the_heap.decreaseKey (adjacent, distance);
+			}
+		} // end for (edge)
+	} // end while (!the_heap.isEmpty())
+}
+
+
+//========================run_monotone_dijkstra=======================
+// Dijkstra's algorithm using the given BucketQueue or RadixHeap to 
+// pick the next vertex. Neither can lower a key in place, so a 
+// vertex is pushed again each time its distance drops, and the 
+// copies popped after the first are skipped. The first copy popped 
+// has the vertex's final distance, as keys come out in order, and a
+// visited vertex is never pushed again, as weights are not negative.
+// 
+// Preconditions: The graph is built and init_row is needed to 
+//		  initialize the source's row. The queue is empty and
+//		  fits the largest weight.
+// 		  		
+// Postconditions: The shortest paths for each of the vertices
+//		   in the graph have been found.
+//==================================================================== 
+template <class W, class D>
+template <class Queue>
+void BasicGraph<W, D>::run_monotone_dijkstra (int the_source, Queue &the_queue) 
+{
+	// Used for traversing the vertex's run of the CSR arrays.
+	int edge, last;
+
+	// The current vertex, its adjacent vertex, and the new distance.
+	int vertex, adjacent;
+	D distance;
+
+	// The row's arrays, each read only where it is needed.
+	D *distances  = &my_table [the_source].distance [0];
+	int *previous = &my_table [the_source].prev_vertex [0];
+	vector<bool> &visited = my_table [the_source].visited;
+
+	// Distance from source to source is zero.
+	distances [the_source] = 0;
+	previous [the_source]  = the_source; 
+	the_queue.push (the_source, 0);
+
+	while (!the_queue.isEmpty()) {
+		// Get the vertex associated with the shortest distance,
+		// skipping the copies of vertices already visited.
+		vertex = the_queue.pop();
+		if (visited [vertex]) continue;
+		visited [vertex] = true;
+
+		last = my_out_offsets[vertex + 1];
+		for (edge = my_out_offsets[vertex]; edge < last; edge++) {
+			adjacent = my_out_targets[edge];
+			distance = add_weight (distances [vertex], my_out_weights[edge]);
+
+			// Found a shorter path, the old copy is skipped.
+			if (distance < distances [adjacent]) {
+				distances [adjacent] = distance;
+				previous [adjacent]  = vertex;
+				the_queue.push (adjacent, distance);
+			}
+		}
+	}
+}
+
+
+//========================find_and_vist_minimum=======================
+// Finds and returns the vertex with the minimum distance from the 
+// vertices that have not yet been visited within my_table
+//
+// It then marks the returned vertex as being visisted.
+//
+// The vector holds the distance of every vertex not visited yet and
+// INFINITE for the rest, so the scan reads one key per vertex and 
+// needs no visited or unreached test. For int distances MinimumScan
+// compares 8 or 4 of them at a time where the processor can.
+//
+// Preconditions:  The vector holds my_size + 1 keys, set as above.
+//		   the_source needs to be a valid index of my_table.
+//		    	  		  		
+// Postconditions: Returns the vertex with the shortest distance 
+//		   from the vertex that has not yet been visited, and
+//		   sets its key to INFINITE.
+//==================================================================== 
+template <class W, class D>
+int BasicGraph<W, D>::find_and_visit_minimum (int the_source, vector<D> &the_keys)
+{
+	int vertex;
+
+	// The first vertex with the shortest distance. A visited or
+	// unreached vertex is INFINITE, so it is only found when 
+	// every vertex is.
+	vertex = MinimumScan::find (&the_keys [0], 1, my_size + 1);
+
+	if (the_keys [vertex] == INFINITE) {
+		return -1;
+	}  else  {
+		my_table [the_source].visited [vertex] = true; 
+		the_keys [vertex] = INFINITE;
+		return vertex; 
+	}
+}
+
+
+//========================displayAll==================================
+// Displays the entire graph. Prints out the vertices description, the
+// edges associated with the vertices, and the edge weights. 
+//
+// The V^2 lines are formatted into an OutputBuffer and written in
+// large blocks instead of one flush per line. The paths of a row are
+// all in one shortest path tree, so extend_prefix keeps the path 
+// printed last and only walks back from the next target to where it
+// meets that path, instead of all the way to the source. The rows 
+// and columns go in the order of the numbers from the input, so a 
+// reordered graph prints the same table.
+// 
+// Preconditions: The graph must have already built. 
+//		
+// Postconditions: A detailed graph is desplayed showing all the 
+//		   vertices, the edges, and weights. A path whose length
+//		   does not fit in D is shown as no path, "--".
+//==================================================================== 
+template <class W, class D>
+void BasicGraph<W, D>::displayAll ()
+{
+	int row, col, source, target;
+	const char *data;
+	int length;
+	OutputBuffer out (cout);
+	PathPrefix prefix;
+
+	// Every row is shown, so bring every stale one up to date.
+	for (row = 1; row <= my_size; row++)
+		ensure_row (row);
+
+	// Display the boarder.
+	out.fill ('-', 55);
+	out.put ('|');
+	out.put ('\n');
+	
+	// Display the table column headers. 
+	out.writeText ("Description", 0);
+	out.writeText ("From", 15);
+	out.writeText ("To", 5);
+	out.writeText ("Distance", 11);
+	out.writeText ("Path", 7);
+	out.put ('\n');
+
+	prefix.position.assign (my_size + 1, -1);
+	
+	// Go through each row of the table.
+	for (row = 1; row <= my_size; row++) { 
+		source = internal_id (row);
+
+		// Display vertex description. 
+		get_description (source, data, length);
+		out.write (data, length);
+		out.put ('\n');
+		start_prefix (prefix, source);
+		
+		// Go through each column of the table. 
+		for (col = 1; col <= my_size; col++) {
+			if (col == row) continue;
+			target = internal_id (col);
+
+			// Display the *from* and *to* vertices.  
+			out.writeNumber (row, 23);
+			out.writeNumber (col, 7);
+
+			// Display the distance.
+			// First check if there is a path.
+			if (get_distance (source, target) == -1) {
+				out.writeText ("--", 7);
+				out.put ('\n');
+				continue;
+			}
+			out.writeNumber (my_table [source].distance [target], 7);
+
+			// Display the path, the source padded to 9 wide.
+			extend_prefix (prefix, source, target);
+			out.fill (' ', 9 - prefix.ends [0]);
+			out.write (prefix.text.data(), (int) prefix.text.size());
+			out.put ('\n');
+		} 
+	}
+}
+
+
+//========================display=====================================
+// Displays the path from the first int to the second int. The ints
+// represents vertices in the graph, so they must exist. Prins out the
+// vertices description, the edges associated with the vertices, and
+// the edge weights. 
+// 
+// Preconditions: The provided vertices must exist.
+//		
+// Postconditions: A detailed graph is displayed showing all the 
+//		   vertices, their description, edges, and weights. 
+//==================================================================== 
+template <class W, class D>
+void BasicGraph<W, D>::display(int the_start_v, int the_finish_v)
+{
+	int source, target;
+
+	// Check valid range.
+	if (the_start_v < 1 || the_start_v > my_size ||
+	 	the_finish_v < 1 || the_finish_v > my_size) {
+			return;
+	}
+	source = internal_id (the_start_v);
+	target = internal_id (the_finish_v);
+
+	// In lazy mode a row not computed yet is not worth computing
+	// for one path, a bidirectional search is much cheaper.
+	if (my_lazy && my_table [source].distance.empty()) {
+		display_path (my_path, findPath (the_start_v, the_finish_v));
+		return;
+	}
+
+	// Only the start vertex's row is needed.
+	ensure_row (source);
+
+	// Check if the path exists.
+	if (get_distance (source, target) == -1) 
+		return;	
+
+	table_path (source, target);
+	display_path (my_path, my_table [source].distance [target]);
+} 
+
+	
+//========================table_path==================================
+// Sets my_path to the path from the first int to the second int in
+// the first int's row of the table, by following previous vertices
+// back to the source. A loop, so a long path can not overflow the 
+// stack the way following them recursively could. my_path holds the
+// numbers from the input.
+// 
+// Preconditions: The row is up to date and the second vertex is 
+//		  reachable from the first.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::table_path (int the_source, int the_target)
+{
+	const vector<int> &previous = my_table [the_source].prev_vertex;
+	int vertex;
+
+	my_path.clear();
+	for (vertex = the_target; vertex != the_source; vertex = previous [vertex])
+		my_path.push_back (external_id (vertex));
+	my_path.push_back (external_id (the_source));
+	reverse (my_path.begin(), my_path.end());
+}
+
+
+//========================start_prefix================================
+// Makes the given source the whole path of the PathPrefix, for 
+// displayAll starting a row.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::start_prefix (PathPrefix &the_prefix, int the_source)
+{
+	int i;
+
+	for (i = 0; i < (int) the_prefix.vertices.size(); i++)
+		the_prefix.position [the_prefix.vertices [i]] = -1;
+	the_prefix.vertices.assign (1, the_source);
+	the_prefix.position [the_source] = 0;
+	the_prefix.text = to_string (external_id (the_source));
+	the_prefix.ends.assign (1, (int) the_prefix.text.size());
+}
+
+
+//========================extend_prefix===============================
+// Changes the path of the PathPrefix to the path from the first int 
+// to the second int in the first int's row of the table. Walks back
+// from the target only until a vertex on the current path, whose 
+// part of the path up to there is the same in the new one, then cuts
+// the path and its text after that vertex and appends the vertices 
+// walked over. The source is always on the path, so the walk stops.
+// 
+// Preconditions: The row is up to date, the second vertex is 
+//		  reachable from the first, and the PathPrefix was 
+//		  started from the first.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::extend_prefix (PathPrefix &the_prefix, int the_source, 
+			   int the_target)
+{
+	const vector<int> &previous = my_table [the_source].prev_vertex;
+	int vertex, keep, i;
+
+	the_prefix.walked.clear();
+	for (vertex = the_target; the_prefix.position [vertex] == -1; 
+	     vertex = previous [vertex])
+		the_prefix.walked.push_back (vertex);
+
+	// Cut the path after the vertex where the walk stopped.
+	keep = the_prefix.position [vertex] + 1;
+	for (i = keep; i < (int) the_prefix.vertices.size(); i++)
+		the_prefix.position [the_prefix.vertices [i]] = -1;
+	the_prefix.vertices.resize (keep);
+	the_prefix.ends.resize (keep);
+	the_prefix.text.resize (the_prefix.ends.back());
+
+	// The vertices walked over were walked in reverse.
+	for (i = (int) the_prefix.walked.size() - 1; i >= 0; i--) {
+		vertex = the_prefix.walked [i];
+		the_prefix.position [vertex] = (int) the_prefix.vertices.size();
+		the_prefix.vertices.push_back (vertex);
+		the_prefix.text += ' ';
+		the_prefix.text += to_string (external_id (vertex));
+		the_prefix.ends.push_back ((int) the_prefix.text.size());
+	}
+}
+
+
+//========================findPath====================================
+// Finds the shortest path from the first int to the second int with
+// a bidirectional Dijkstra search and stores its vertices in my_path.
+// The forward search runs from the start over the CSR arrays and the
+// backward search from the finish over the reverse CSR arrays. Each 
+// step settles a vertex on the side whose heap has the smaller top 
+// key. Every edge relaxed into a vertex the other side has reached
+// is a candidate path, and once the two top keys add up to at least
+// the best candidate no shorter path can be found, so the search
+// stops, usually after settling a small part of the graph. The table
+// is not used or changed.
+// 
+// Preconditions: The graph is built.
+//		
+// Postconditions: Returns the length of the path, or -1 if there is
+//		   none, a vertex does not exist, or the length does not
+//		   fit in D. my_path holds the path, or is empty if 
+//		   there is none.
+//====================================================================
+template <class W, class D>
+D BasicGraph<W, D>::findPath (int the_start_v, int the_finish_v)
+{
+	// The best path so far: its length, and the edge joining the
+	// two searches.
+	D best = -1;
+	int from = 0, to = 0;
+	int vertex;
+
+	my_path.clear();
+	my_settled = 0;
+	if (the_start_v < 1 || the_start_v > my_size ||
+	    the_finish_v < 1 || the_finish_v > my_size)
+		return -1;
+	if (the_start_v == the_finish_v) {
+		my_path.push_back (the_start_v);
+		return 0;
+	}
+
+	// The searches use the internal vertices.
+	the_start_v  = internal_id (the_start_v);
+	the_finish_v = internal_id (the_finish_v);
+
+	compile_reverse();
+	start_search (my_forward, the_start_v);
+	start_search (my_backward, the_finish_v);
+
+	while (!my_forward.heap.isEmpty() && !my_backward.heap.isEmpty()) {
+		if (best != -1 && my_forward.heap.topKey() >= 
+		    best - my_backward.heap.topKey())
+			break;
+		if (my_forward.heap.topKey() <= my_backward.heap.topKey())
+			settle_next (my_forward, my_backward, my_out_offsets, 
+				     my_out_targets, my_out_weights, true, 
+				     best, from, to);
+		else
+			settle_next (my_backward, my_forward, &my_in_offsets [0],
+				     my_in_sources.empty() ? NULL : &my_in_sources [0],
+				     my_in_weights.empty() ? NULL : &my_in_weights [0], 
+				     false, best, from, to);
+	}
+	if (best == -1) return -1;
+
+	// Walk back from the joining edge to the start, then forward
+	// from it to the finish.
+	trace_path (from);
+	for (vertex = to; vertex != the_finish_v; vertex = my_backward.parent [vertex])
+		my_path.push_back (vertex);
+	my_path.push_back (the_finish_v);
+	to_external (my_path);
+	return best;
+}
+
+
+//========================findPath====================================
+// Finds the shortest path from the first int to the second int with
+// an A* search guided by the Heuristic and stores its vertices in 
+// my_path. It is the heap Dijkstra run from the start, except that a
+// vertex's key is its distance plus the Heuristic's estimate of the
+// rest of the way. With a consistent Heuristic a vertex's distance 
+// is final when it is visited, as in Dijkstra's algorithm, so the
+// search stops as soon as the finish is visited. The table is not 
+// used or changed. The Heuristic is given the numbers from the input.
+// 
+// Preconditions: The graph is built, and the Heuristic is admissible
+//		  and consistent for it.
+//		
+// Postconditions: Returns the length of the path, or -1 if there is
+//		   none, a vertex does not exist, or the length does not
+//		   fit in D. my_path holds the path, or is empty if 
+//		   there is none.
+//====================================================================
+template <class W, class D>
+D BasicGraph<W, D>::findPath (int the_start_v, int the_finish_v, 
+			      const Heuristic &the_heuristic)
+{
+	// Used for traversing the vertex's run of the CSR arrays.
+	int edge, last;
+
+	// The current vertex, its adjacent vertex, and the new distance.
+	int vertex, adjacent;
+	D distance;
+
+	// The internal vertex of the finish.
+	int finish;
+
+	my_path.clear();
+	my_settled = 0;
+	if (the_start_v < 1 || the_start_v > my_size ||
+	    the_finish_v < 1 || the_finish_v > my_size)
+		return -1;
+	finish = internal_id (the_finish_v);
+
+	compile();
+	start_search (my_forward, internal_id (the_start_v));
+
+	while (!my_forward.heap.isEmpty()) {
+		vertex = my_forward.heap.pop();
+		my_forward.settled [vertex] = true;
+		my_settled++;
+		if (vertex == finish) break;
+
+		last = my_out_offsets [vertex + 1];
+		for (edge = my_out_offsets [vertex]; edge < last; edge++) {
+			adjacent = my_out_targets [edge];
+
+			// The shortest path to it has already been found.
+			if (my_forward.settled [adjacent]) continue;
+
+			distance = add_weight (my_forward.distance [vertex], 
+					       my_out_weights [edge]);
+
+			// If this is the first time adding a distance to this vertex.
+			if (my_forward.distance [adjacent] == -1) {
+				reach (my_forward, adjacent, distance, vertex);
+				my_forward.heap.push (adjacent, distance + 
+					the_heuristic.estimate (external_id (adjacent), 
+								the_finish_v));
+			}
+
+			// Otherwise only update it if the new distance is shorter.
+			else if (distance < my_forward.distance [adjacent]) {
+				reach (my_forward, adjacent, distance, vertex);
+				my_forward.heap.decreaseKey (adjacent, distance + 
+					the_heuristic.estimate (external_id (adjacent), 
+								the_finish_v));
+			}
+		}
+	}
+	if (!my_forward.settled [finish]) return -1;
+
+	trace_path (finish);
+	to_external (my_path);
+	return my_forward.distance [finish];
+}
+
+
+//========================distanceMatrix==============================
+// Finds the distance from every source in the first vector to every
+// target in the second, and stores them in the D array row by row:
+// the distance from sources[i] to targets[j] goes at index 
+// i * targets.size() + j, -1 if there is no path. A source whose row
+// of the table is computed is read from it. Otherwise Dijkstra's 
+// algorithm runs from it over the CSR arrays with my_forward, and 
+// stops once every target has been visited, which for targets near
+// the source is a small part of the graph. The table is not changed.
+// 
+// Preconditions: The graph is built, and the array holds 
+//		  sources.size() * targets.size() distances.
+//		
+// Postconditions: Returns false, and stores nothing, if a vertex 
+//		   does not exist. A distance that does not fit in D 
+//		   is stored as -1.
+//====================================================================
+template <class W, class D>
+bool BasicGraph<W, D>::distanceMatrix (const vector<int> &the_sources, 
+				       const vector<int> &the_targets, 
+				       D *the_matrix)
+{
+	// Which vertices are targets, and how many different ones.
+	vector<bool> wanted (my_size + 1, false);
+	int target_count = 0;
+
+	// Used for traversing the vertex's run of the CSR arrays.
+	int edge, last;
+
+	// The current vertex, its adjacent vertex, and the new distance.
+	int vertex, adjacent;
+	D distance;
+
+	int i, j, source, remaining, columns = (int) the_targets.size();
+	D *row;
+
+	// The internal vertices of the targets.
+	vector<int> targets (columns);
+
+	my_settled = 0;
+	for (i = 0; i < (int) the_sources.size(); i++) {
+		if (the_sources [i] < 1 || the_sources [i] > my_size) 
+			return false;
+	}
+	for (j = 0; j < columns; j++) {
+		if (the_targets [j] < 1 || the_targets [j] > my_size) 
+			return false;
+		targets [j] = internal_id (the_targets [j]);
+		if (!wanted [targets [j]]) {
+			wanted [targets [j]] = true;
+			target_count++;
+		}
+	}
+	if (columns == 0) return true;
+
+	compile();
+	for (i = 0; i < (int) the_sources.size(); i++) {
+		source = internal_id (the_sources [i]);
+		row    = the_matrix + (long long) i * columns;
+
+		// The row is in the table already.
+		if (!my_table [source].distance.empty()) {
+			for (j = 0; j < columns; j++)
+				row [j] = get_distance (source, targets [j]);
+			continue;
+		}
+
+		start_search (my_forward, source);
+		remaining = target_count;
+		while (!my_forward.heap.isEmpty()) {
+			vertex = my_forward.heap.pop();
+			my_forward.settled [vertex] = true;
+			my_settled++;
+
+			// Every target has its distance.
+			if (wanted [vertex] && --remaining == 0) break;
+
+			last = my_out_offsets [vertex + 1];
+			for (edge = my_out_offsets [vertex]; edge < last; edge++) {
+				adjacent = my_out_targets [edge];
+				if (my_forward.settled [adjacent]) continue;
+
+				distance = add_weight (my_forward.distance [vertex], 
+						       my_out_weights [edge]);
+				if (my_forward.distance [adjacent] == -1) {
+					reach (my_forward, adjacent, distance, vertex);
+					my_forward.heap.push (adjacent, distance);
+				} else if (distance < my_forward.distance [adjacent]) {
+					reach (my_forward, adjacent, distance, vertex);
+					my_forward.heap.decreaseKey (adjacent, distance);
+				}
+			}
+		}
+
+		// A target not visited was not reached, and has -1.
+		for (j = 0; j < columns; j++)
+			row [j] = my_forward.distance [targets [j]];
+	}
+	return true;
+}
+
+
+//========================findWithin==================================
+// Finds every vertex whose distance from the int is at most the
+// given radius, such as everything within 15 minutes of a place.
+// Dijkstra's algorithm visits vertices in order of distance, so it 
+// stops at the first one past the radius. my_forward only clears 
+// the vertices the last search reached, so a small radius costs 
+// only the part of the graph it covers, not O(V). The table is not
+// used or changed.
+// 
+// Preconditions: The graph is built.
+//		
+// Postconditions: Returns the number of vertices found, the first 
+//		   one included, or -1 if it does not exist. my_found
+//		   and my_found_distances hold them, nearest first.
+//====================================================================
+template <class W, class D>
+int BasicGraph<W, D>::findWithin (int the_source, D the_radius)
+{
+	my_found.clear();
+	my_found_distances.clear();
+	my_settled = 0;
+	if (the_source < 1 || the_source > my_size) return -1;
+	if (the_radius < 0) return 0;
+
+	search_bounded (internal_id (the_source), the_radius, my_size);
+	return (int) my_found.size();
+}
+
+
+//========================findNearest=================================
+// Finds the vertices nearest to the first int, the first int 
+// included, up to the number given by the second int. Dijkstra's 
+// algorithm visits vertices in order of distance, so it stops once 
+// that many are visited. The table is not used or changed.
+// 
+// Preconditions: The graph is built.
+//		
+// Postconditions: Returns the number of vertices found, fewer if not
+//		   that many are reached, or -1 if the first int does
+//		   not exist. my_found and my_found_distances hold 
+//		   them, nearest first.
+//====================================================================
+template <class W, class D>
+int BasicGraph<W, D>::findNearest (int the_source, int the_count)
+{
+	my_found.clear();
+	my_found_distances.clear();
+	my_settled = 0;
+	if (the_source < 1 || the_source > my_size) return -1;
+	if (the_count < 1) return 0;
+
+	search_bounded (internal_id (the_source), INFINITE, the_count);
+	return (int) my_found.size();
+}
+
+
+//========================getFound====================================
+// Returns the vertices found by the last findWithin or findNearest,
+// nearest first.
+//====================================================================
+template <class W, class D>
+const vector<int> &BasicGraph<W, D>::getFound () const
+{
+	return my_found;
+}
+
+
+//========================getFoundDistances===========================
+// Returns the distances of the vertices in getFound, in the same 
+// order.
+//====================================================================
+template <class W, class D>
+const vector<D> &BasicGraph<W, D>::getFoundDistances () const
+{
+	return my_found_distances;
+}
+
+
+//========================getSize=====================================
+// Returns the number of vertices. They are numbered from 1 to 
+// getSize.
+//====================================================================
+template <class W, class D>
+int BasicGraph<W, D>::getSize () const
+{
+	return my_size;
+}
+
+
+//========================getDistance=================================
+// Returns the length of the shortest path from the first int to the
+// second int, computing the first int's row of the table if it is not
+// up to date.
+// 
+// Preconditions: The graph is built.
+//		
+// Postconditions: Returns -1 if there is no path or a vertex does 
+//		   not exist, and also if the distance does not fit in
+//		   D, since add_weight stops such a path at INFINITE.
+//====================================================================
+template <class W, class D>
+D BasicGraph<W, D>::getDistance (int the_source, int the_target)
+{
+	if (the_source < 1 || the_source > my_size ||
+	    the_target < 1 || the_target > my_size) return -1;
+
+	the_source = internal_id (the_source);
+	ensure_row (the_source);
+	return get_distance (the_source, internal_id (the_target));
+}
+
+
+//========================getPath=====================================
+// Stores the shortest path from the first int to the second int in 
+// the array, computing the first int's row of the table if it is not
+// up to date. The last int is how many ints the array holds. The 
+// previous vertices are followed twice, once to count the vertices 
+// and once to store them from the last position back, so the path 
+// comes out in order without a scratch vector.
+// 
+// Preconditions: The graph is built, and the array holds at least 
+//		  the last int ints.
+//		
+// Postconditions: Returns the number of vertices on the path, or -1
+//		   if there is none, a vertex does not exist, or its 
+//		   length does not fit in D. If the
+//		   path does not fit in the array, nothing is stored 
+//		   and the number returned is the size it needs.
+//====================================================================
+template <class W, class D>
+int BasicGraph<W, D>::getPath (int the_source, int the_target, int *the_path, 
+		    int the_capacity)
+{
+	const int *previous;
+	int vertex, length, i;
+
+	if (getDistance (the_source, the_target) == -1) return -1;
+	the_source = internal_id (the_source);
+	the_target = internal_id (the_target);
+	previous   = &my_table [the_source].prev_vertex [0];
+
+	length = 1;
+	for (vertex = the_target; vertex != the_source; vertex = previous [vertex])
+		length++;
+	if (length > the_capacity) return length;
+
+	i = length - 1;
+	for (vertex = the_target; vertex != the_source; vertex = previous [vertex])
+		the_path [i--] = external_id (vertex);
+	the_path [0] = external_id (the_source);
+	return length;
+}
+
+
+//========================getPredecessors=============================
+// Returns the shortest path tree from the given source, computing its
+// row of the table if it is not up to date. Entry v is the vertex 
+// before v on its shortest path, the source for the source, and 0 if
+// v is not reached. It is the row's own array, so nothing is copied,
+// except in a reordered graph, where the tree is translated into 
+// my_predecessors, indexed and filled with the numbers from the input.
+// 
+// Preconditions: The graph is built.
+//		
+// Postconditions: Returns NULL if the source does not exist. The 
+//		   ints stay valid until the graph is changed or 
+//		   another graph is assigned to it.
+//====================================================================
+template <class W, class D>
+const int *BasicGraph<W, D>::getPredecessors (int the_source)
+{
+	const int *previous;
+	int vertex;
+
+	if (the_source < 1 || the_source > my_size) return NULL;
+
+	the_source = internal_id (the_source);
+	ensure_row (the_source);
+	previous = &my_table [the_source].prev_vertex [0];
+	if (my_external_ids.empty()) return previous;
+
+	my_predecessors.assign (my_size + 1, 0);
+	for (vertex = 1; vertex <= my_size; vertex++) {
+		if (previous [vertex] != 0)
+			my_predecessors [external_id (vertex)] = external_id (previous [vertex]);
+	}
+	return &my_predecessors [0];
+}
+
+
+//========================search_bounded==============================
+// Runs Dijkstra's algorithm from the first int over the CSR arrays 
+// with my_forward. It stops before visiting a vertex farther than 
+// the given radius, or once the last int vertices are visited, and 
+// keeps the visited vertices and their distances in my_found and 
+// my_found_distances.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::search_bounded (int the_source, D the_radius, int the_limit)
+{
+	// Used for traversing the vertex's run of the CSR arrays.
+	int edge, last;
+
+	// The current vertex, its adjacent vertex, and the new distance.
+	int vertex, adjacent;
+	D distance;
+
+	compile();
+	start_search (my_forward, the_source);
+
+	while (!my_forward.heap.isEmpty()) {
+		// Every vertex left is past the radius.
+		if (my_forward.heap.topKey() > the_radius) break;
+
+		vertex = my_forward.heap.pop();
+		my_forward.settled [vertex] = true;
+		my_settled++;
+		my_found.push_back (external_id (vertex));
+		my_found_distances.push_back (my_forward.distance [vertex]);
+		if ((int) my_found.size() == the_limit) break;
+
+		last = my_out_offsets [vertex + 1];
+		for (edge = my_out_offsets [vertex]; edge < last; edge++) {
+			adjacent = my_out_targets [edge];
+			if (my_forward.settled [adjacent]) continue;
+
+			distance = add_weight (my_forward.distance [vertex], 
+					       my_out_weights [edge]);
+			if (my_forward.distance [adjacent] == -1) {
+				reach (my_forward, adjacent, distance, vertex);
+				my_forward.heap.push (adjacent, distance);
+			} else if (distance < my_forward.distance [adjacent]) {
+				reach (my_forward, adjacent, distance, vertex);
+				my_forward.heap.decreaseKey (adjacent, distance);
+			}
+		}
+	}
+}
+
+
+//========================settledCount================================
+// Returns the number of vertices the last findPath, distanceMatrix, 
+// findWithin or findNearest visited.
+//====================================================================
+template <class W, class D>
+int BasicGraph<W, D>::settledCount () const
+{
+	return my_settled;
+}
+
+
+//========================trace_path==================================
+// Sets my_path to the path the forward search found from its source
+// to the given vertex, by following parents back to the source.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::trace_path (int the_vertex)
+{
+	int vertex;
+
+	my_path.clear();
+	for (vertex = the_vertex; my_forward.parent [vertex] != vertex; 
+	     vertex = my_forward.parent [vertex])
+		my_path.push_back (vertex);
+	my_path.push_back (vertex);
+	reverse (my_path.begin(), my_path.end());
+}
+
+
+//========================distances_from==============================
+// Runs Dijkstra's algorithm from the given vertex and sets the vector
+// to the distance of every vertex, -1 if it is not reached. It goes 
+// forward over the CSR arrays if the bool is true, giving distances
+// from the vertex, and backward over the reverse CSR arrays if it is
+// false, giving distances to it. Used by Landmarks, which needs both
+// for every landmark. The table is not used or changed. The vertex 
+// and the vector use the numbers from the input, so a reordered 
+// graph translates the distances once the search is done.
+// 
+// Preconditions: The graph is built and the vertex exists.
+//		
+// Postconditions: The vector holds my_size + 1 distances, not using
+//		   index 0.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::distances_from (int the_source, bool the_forward, 
+				       vector<D> &the_distances)
+{
+	const int *offsets, *targets;
+	const W *weights;
+	vector<bool> settled (my_size + 1, false);
+	BasicHeap<D> heap (my_heap.getArity());
+	int edge, last, vertex, adjacent;
+	D distance;
+
+	compile_reverse();
+	if (the_forward) {
+		offsets = my_out_offsets;
+		targets = my_out_targets;
+		weights = my_out_weights;
+	} else {
+		offsets = &my_in_offsets [0];
+		targets = my_in_sources.empty() ? NULL : &my_in_sources [0];
+		weights = my_in_weights.empty() ? NULL : &my_in_weights [0];
+	}
+
+	the_source = internal_id (the_source);
+	the_distances.assign (my_size + 1, -1);
+	heap.reset (my_size);
+	the_distances [the_source] = 0;
+	heap.push (the_source, 0);
+
+	while (!heap.isEmpty()) {
+		vertex = heap.pop();
+		settled [vertex] = true;
+
+		last = offsets [vertex + 1];
+		for (edge = offsets [vertex]; edge < last; edge++) {
+			adjacent = targets [edge];
+			if (settled [adjacent]) continue;
+
+			distance = add_weight (the_distances [vertex], weights [edge]);
+			if (the_distances [adjacent] == -1) {
+				the_distances [adjacent] = distance;
+				heap.push (adjacent, distance);
+			} else if (distance < the_distances [adjacent]) {
+				the_distances [adjacent] = distance;
+				heap.decreaseKey (adjacent, distance);
+			}
+		}
+	}
+	if (my_external_ids.empty()) return;
+
+	vector<D> internal (my_size + 1, -1);
+	internal.swap (the_distances);
+	for (vertex = 1; vertex <= my_size; vertex++)
+		the_distances [external_id (vertex)] = internal [vertex];
+}
+
+
+//========================start_search================================
+// Clears the given search and starts it from the given vertex. Only
+// the vertices the last search reached are cleared, so a short 
+// search stays cheap on a large graph.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::start_search (Search &the_search, int the_source)
+{
+	int i, vertex;
+
+	if ((int) the_search.distance.size() != my_size + 1) {
+		the_search.distance.assign (my_size + 1, -1); // Not using index 0.
+		the_search.parent.assign (my_size + 1, 0);
+		the_search.settled.assign (my_size + 1, false);
+		the_search.touched.clear();
+	}
+	for (i = 0; i < (int) the_search.touched.size(); i++) {
+		vertex = the_search.touched [i];
+		the_search.distance [vertex] = -1;
+		the_search.settled [vertex]  = false;
+	}
+	the_search.touched.clear();
+	the_search.heap.reset (my_size);
+
+	reach (the_search, the_source, 0, the_source);
+	the_search.heap.push (the_source, 0);
+}
+
+
+//========================reach=======================================
+// Gives the vertex the first int the given distance in the given 
+// search, with the last int as its parent.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::reach (Search &the_search, int the_vertex, D the_distance,
+			      int the_parent)
+{
+	if (the_search.distance [the_vertex] == -1)
+		the_search.touched.push_back (the_vertex);
+	the_search.distance [the_vertex] = the_distance;
+	the_search.parent [the_vertex]   = the_parent;
+}
+
+
+//========================settle_next=================================
+// Settles the vertex at the top of the first search's heap and 
+// relaxes its edges in the given CSR arrays, which are the reverse
+// ones for the backward search. Any edge that reaches a vertex the 
+// second search has reached joins the two searches into a path. The
+// best such path is kept in the references: its length (-1 if none
+// yet), and the vertices at the ends of the joining edge, in forward
+// order whichever search found it.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::settle_next (Search &the_search, Search &the_other, 
+				    const int *the_offsets, const int *the_targets, 
+				    const W *the_weights, bool the_forward, 
+				    D &the_best, int &the_from, int &the_to)
+{
+	int vertex, adjacent, edge, last;
+	D distance;
+
+	vertex = the_search.heap.pop();
+	the_search.settled [vertex] = true;
+	my_settled++;
+
+	last = the_offsets [vertex + 1];
+	for (edge = the_offsets [vertex]; edge < last; edge++) {
+		adjacent = the_targets [edge];
+		distance = add_weight (the_search.distance [vertex], the_weights [edge]);
+
+		if (!the_search.settled [adjacent]) {
+			if (the_search.distance [adjacent] == -1) {
+				reach (the_search, adjacent, distance, vertex);
+				the_search.heap.push (adjacent, distance);
+			} else if (distance < the_search.distance [adjacent]) {
+				reach (the_search, adjacent, distance, vertex);
+				the_search.heap.decreaseKey (adjacent, distance);
+			}
+		}
+
+		// Join the searches through this edge, unless the path is
+		// too long for a D.
+		if (the_other.distance [adjacent] != -1 &&
+		    the_other.distance [adjacent] < INFINITE - distance &&
+		    (the_best == -1 || distance + the_other.distance [adjacent] < the_best)) {
+			the_best = distance + the_other.distance [adjacent];
+			the_from = the_forward ? vertex : adjacent;
+			the_to   = the_forward ? adjacent : vertex;
+		}
+	}
+}
+
+
+//========================display_path================================
+// Prints the given path, with the given length, the way display 
+// prints a path from the table. Prints nothing if the length is -1.
+// The path holds the numbers from the input. Also used by 
+// ContractionHierarchy.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::display_path (const vector<int> &the_path, D the_distance) const
+{
+	int i;
+
+	if (the_distance == -1) return;
+
+	cout << the_path.front();
+	cout << setw(7) << the_path.back();
+	cout << setw(7) << the_distance;
+
+	cout << setw(9) << the_path [0];
+	for (i = 1; i < (int) the_path.size(); i++)
+		cout << " " << the_path [i];
+	cout << endl;
+
+	for (i = 0; i < (int) the_path.size(); i++) {
+		if (i > 0) cout << endl;
+		write_description (internal_id (the_path [i]));
+	}
+	cout << endl;
+}
+
+
+//========================setStrategy=================================
+// Selects how Dijkstra's algorithm picks the next vertex to visit,
+// in place of the default AUTO. The int is the arity of the heap, 
+// used by the HEAP strategy only. The table is not recomputed.
+// 
+// Preconditions: None.
+//		
+// Postconditions: Later shortest path runs use the given strategy.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::setStrategy (Strategy the_strategy, int the_arity)
+{
+	my_strategy = the_strategy;
+	if (the_strategy != LINEAR_SCAN)
+		my_heap.setArity (the_arity);
+}
+
+
+//========================is_dense====================================
+// Returns true if the graph has enough edges for the linear scan to 
+// beat the heap. A source costs the linear scan about V^2 steps, 
+// each one a vector compare of a few ints, and the heap about E sift
+// steps of log V each, branchy and scattered. On random graphs of 
+// 1500 vertices the scan wins once E is past about V^2 / 80, and 
+// DENSE_DIVISOR leaves some margin below that.
+//
+// Preconditions: The CSR arrays are compiled.
+//====================================================================
+template <class W, class D>
+bool BasicGraph<W, D>::is_dense () const
+{
+	long long edges = (my_size == 0) ? 0 : my_out_offsets [my_size + 1];
+	return edges * DENSE_DIVISOR >= (long long) my_size * my_size;
+}
+
+
+//========================getStrategy=================================
+// Returns the strategy used by Dijkstra's algorithm.
+//====================================================================
+template <class W, class D>
+typename BasicGraph<W, D>::Strategy
+BasicGraph<W, D>::getStrategy () const
+{
+	return my_strategy;
+}
+
+
+//========================setLazy=====================================
+// Turns lazy mode on or off. In lazy mode, rows of the table are 
+// only computed when display or displayAll needs them, and inserting
+// or removing an edge only repairs the rows already computed. Turning
+// lazy mode off brings the whole table up to date.
+// 
+// Preconditions: None.
+//		
+// Postconditions: The graph is in the requested mode.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::setLazy (bool the_lazy)
+{
+	int row;
+
+	my_lazy = the_lazy;
+	if (!my_lazy) {
+		for (row = 1; row <= my_size; row++)
+			ensure_row (row);
+	}
+}
+
+
+//========================isLazy======================================
+// Returns true if the graph is in lazy mode.
+//====================================================================
+template <class W, class D>
+bool BasicGraph<W, D>::isLazy () const
+{
+	return my_lazy;
+}
+
+
+//========================setThreadCount==============================
+// Sets the number of threads findShortestPath uses to compute all 
+// the rows of the table. Zero uses one thread per core, and one 
+// computes the rows serially.
+// 
+// Preconditions: None.
+//		
+// Postconditions: Later calls to findShortestPath use the given
+//		   number of threads.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::setThreadCount (int the_threads)
+{
+	if (the_threads == 0)
+		the_threads = (int) thread::hardware_concurrency();
+	my_threads = (the_threads < 1) ? 1 : the_threads;
+}
+
+
+//========================getThreadCount==============================
+// Returns the number of threads used by findShortestPath.
+//====================================================================
+template <class W, class D>
+int BasicGraph<W, D>::getThreadCount () const
+{
+	return my_threads;
+}
+
+
+//========================saveBinary==================================
+// Writes this graph to the named file in the binary format read by
+// openBinary. Together with buildGraph this converts the text format
+// to the binary one.
+//
+// The file holds, in order, a BinaryHeader, the CSR offsets (one per
+// vertex plus two, not using index 0), targets and weights, the 
+// description offsets (laid out like the CSR offsets), and a pool of
+// all the descriptions with no '\0' between them. Every number is a
+// native int except the weights, which are native Ws padded with
+// zero bytes to whole ints. A reordered graph is written in its 
+// internal order, with BINARY_VERSION_IDS, and the number from the 
+// input of each vertex (one per vertex plus one, not using index 0)
+// between the weights and the description offsets.
+// 
+// Preconditions: The graph is built.
+//		
+// Postconditions: Returns true if the whole file was written, false
+//		   otherwise.
+//====================================================================
+template <class W, class D>
+bool BasicGraph<W, D>::saveBinary (const char *the_path)
+{
+	BinaryHeader header;
+	vector<int> desc_offsets (my_size + 2, 0);
+	const char padding [sizeof (int)] = { 0 };
+	const char *data;
+	int vertex, length, edges;
+
+	compile();
+	ofstream outfile (the_path, ios::out | ios::binary | ios::trunc);
+	if (!outfile) return false;
+
+	// Lay out the descriptions end to end.
+	for (vertex = 1; vertex <= my_size; vertex++) {
+		get_description (vertex, data, length);
+		desc_offsets [vertex + 1] = desc_offsets [vertex] + length;
+	}
+
+	edges = (my_size > 0) ? my_out_offsets [my_size + 1] : 0;
+	memcpy (header.magic, BINARY_MAGIC, sizeof (header.magic));
+	header.version   = (my_external_ids.empty() ? BINARY_VERSION : BINARY_VERSION_IDS) +
+			   256 * weight_tag();
+	header.vertices  = my_size;
+	header.edges     = edges;
+	header.pool_size = desc_offsets [my_size + 1];
+
+	outfile.write ((const char *) &header, sizeof (header));
+	if (my_size > 0) {
+		outfile.write ((const char *) my_out_offsets, (my_size + 2) * sizeof (int));
+		outfile.write ((const char *) my_out_targets, edges * sizeof (int));
+		outfile.write ((const char *) my_out_weights, edges * sizeof (W));
+		outfile.write (padding, weights_bytes (edges) - edges * sizeof (W));
+	}
+	if (!my_external_ids.empty())
+		outfile.write ((const char *) &my_external_ids [0], (my_size + 1) * sizeof (int));
+	outfile.write ((const char *) &desc_offsets [0], (my_size + 2) * sizeof (int));
+	for (vertex = 1; vertex <= my_size; vertex++) {
+		get_description (vertex, data, length);
+		outfile.write (data, length);
+	}
+	return (bool) outfile;
+}
+
+
+//========================openBinary==================================
+// Replaces this graph with the one in the named file, written by 
+// saveBinary. The file is memory mapped and the CSR arrays and 
+// descriptions are read straight from the mapped pages, so opening 
+// does not parse or copy the graph. In eager mode the table is then
+// filled by findShortestPath, so open in lazy mode to keep startup
+// cheap.
+//
+// Every size in the header is checked against the length of the 
+// file, in long long so a hostile header can not overflow the 
+// check, and the ends of the CSR and description offsets are 
+// checked against the header. If the bool is true, the default, 
+// check_arrays then checks every array in one pass over the file, 
+// so a corrupt file is refused instead of read out of bounds. That
+// pass is O(V+E), so the default open is O(V+E) too. A file from a
+// trusted source, like one just written by saveBinary, is opened in
+// O(1) by passing false.
+//
+// A mapped graph is read-only. Inserting or removing an edge first
+// builds the adjacency lists from the mapping and releases it.
+// 
+// A file written by a reordered graph opens reordered: the mapped 
+// arrays are in its internal order, and the numbers from the input
+// are copied into my_external_ids and my_internal_ids. They are 
+// always checked, since they are copied anyway.
+// 
+// Preconditions: The file was written by saveBinary on a machine 
+//		  with the same int size and byte order. A file written
+//		  by a graph with another weight type is not opened. If
+//		  the bool is false, the file is trusted to be intact.
+//		
+// Postconditions: Returns true if the file was opened. Returns false
+//		   and leaves this graph unchanged if it could not be
+//		   opened or is not in the expected format.
+//====================================================================
+template <class W, class D>
+bool BasicGraph<W, D>::openBinary (const char *the_path, bool the_check)
+{
+	int fd;
+	struct stat info;
+	void *mapping;
+	const BinaryHeader *header;
+	const int *numbers, *ids, *desc_offsets;
+	long long expected, vertices, edges, pool_size, id_count;
+	int vertex, version;
+	vector<bool> seen;
+
+	fd = open (the_path, O_RDONLY);
+	if (fd < 0) return false;
+	if (fstat (fd, &info) != 0 || 
+	    info.st_size < (off_t) sizeof (BinaryHeader)) {
+		close (fd);
+		return false;
+	}
+
+	// The mapping stays valid after the file is closed.
+	mapping = mmap (NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close (fd);
+	if (mapping == MAP_FAILED) return false;
+
+	// Check the header before trusting any of the sizes.
+	header    = (const BinaryHeader *) mapping;
+	version   = header->version - 256 * weight_tag();
+	vertices  = header->vertices;
+	edges     = header->edges;
+	pool_size = header->pool_size;
+	id_count  = (version == BINARY_VERSION_IDS) ? vertices + 1 : 0;
+	expected  = (long long) sizeof (BinaryHeader) +
+		    (2 * (vertices + 2) + edges + id_count) * (long long) sizeof (int) +
+		    weights_bytes (edges) + pool_size;
+	if (memcmp (header->magic, BINARY_MAGIC, sizeof (header->magic)) != 0 ||
+	    (version != BINARY_VERSION && version != BINARY_VERSION_IDS) || 
+	    vertices < 1 || edges < 0 || pool_size < 0 || 
+	    (long long) info.st_size < expected) {
+		munmap (mapping, info.st_size);
+		return false;
+	}
+
+	numbers      = (const int *) (header + 1);
+	ids          = (const int *) ((const char *) (numbers + vertices + 2 + edges) + 
+				      weights_bytes (edges));
+	desc_offsets = ids + id_count;
+
+	// The offsets must end where the header says, and with the
+	// bool true every array must be in bounds.
+	if (numbers [1] != 0 || numbers [vertices + 1] != edges ||
+	    desc_offsets [1] != 0 || desc_offsets [vertices + 1] != pool_size ||
+	    (the_check && !check_arrays (numbers, (const W *) (numbers + vertices + 2 + edges),
+					 desc_offsets, header->vertices))) {
+		munmap (mapping, info.st_size);
+		return false;
+	}
+
+	// The numbers from the input must name every vertex once.
+	seen.assign (id_count, false);
+	for (vertex = 1; vertex < id_count; vertex++) {
+		if (ids [vertex] < 1 || ids [vertex] >= id_count || seen [ids [vertex]]) {
+			munmap (mapping, info.st_size);
+			return false;
+		}
+		seen [ids [vertex]] = true;
+	}
+
+	delete_vertices();
+	my_mapping      = mapping;
+	my_mapping_size = info.st_size;
+
+	my_out_offsets  = numbers;
+	my_out_targets  = my_out_offsets + vertices + 2;
+	my_out_weights  = (const W *) (my_out_targets + edges);
+	my_desc_offsets = desc_offsets;
+	my_desc_pool    = (const char *) (my_desc_offsets + vertices + 2);
+
+	if (id_count > 0) {
+		my_external_ids.assign (ids, ids + id_count);
+		my_internal_ids.assign (id_count, 0);
+		for (vertex = 1; vertex < id_count; vertex++)
+			my_internal_ids [ids [vertex]] = vertex;
+	}
+
+	my_size     = header->vertices;
+	my_compiled = true;
+
+	// Finding the largest weight reads every edge, so it waits
+	// until a strategy needs it.
+	my_max_weight_known = false;
+	init_table();
+	if (!my_lazy) findShortestPath();
+	return true;
+}
+
+
+//========================check_arrays================================
+// Returns true if the arrays of a binary file are safe to use: the 
+// CSR offsets (the first int pointer) and the description offsets 
+// (the second) never go down, the targets after the CSR offsets are
+// all vertices, and no weight is negative or NaN, which the monotone
+// queues could not take. The int is the number of vertices, and the
+// ends of both offset arrays have been checked already, so every
+// offset is in bounds once they do not go down.
+// 
+// Preconditions: The arrays are as long as the header says.
+//		
+// Postconditions: None.
+//====================================================================
+template <class W, class D>
+bool BasicGraph<W, D>::check_arrays (const int *the_offsets, const W *the_weights,
+				     const int *the_desc_offsets, int the_vertices)
+{
+	const int *targets = the_offsets + the_vertices + 2;
+	int vertex, edge;
+
+	for (vertex = 1; vertex <= the_vertices; vertex++) {
+		if (the_offsets [vertex] > the_offsets [vertex + 1] ||
+		    the_desc_offsets [vertex] > the_desc_offsets [vertex + 1])
+			return false;
+	}
+	for (edge = 0; edge < the_offsets [the_vertices + 1]; edge++) {
+		if (targets [edge] < 1 || targets [edge] > the_vertices ||
+		    !(the_weights [edge] >= 0))
+			return false;
+	}
+	return true;
+}
+
+
+//========================weight_tag==================================
+// Returns the number that says what type the weights in a binary 
+// file are: 0 for int, so those files are the same as before there
+// were other types, and otherwise the size of W, plus 16 if it is 
+// signed and 32 if it is floating point.
+//====================================================================
+template <class W, class D>
+int BasicGraph<W, D>::weight_tag ()
+{
+	if (is_same<W, int>::value) return 0;
+	return (int) sizeof (W) + (numeric_limits<W>::is_signed ? 16 : 0) +
+	       (numeric_limits<W>::is_integer ? 0 : 32);
+}
+
+
+//========================weights_bytes===============================
+// Returns the bytes the given number of weights take in a binary 
+// file, rounded up to whole ints so what follows them stays aligned.
+//====================================================================
+template <class W, class D>
+long long BasicGraph<W, D>::weights_bytes (long long the_count)
+{
+	long long bytes = the_count * (long long) sizeof (W);
+	return (bytes + sizeof (int) - 1) / sizeof (int) * sizeof (int);
+}
+
+
+//========================snapshot====================================
+// Returns a read-only copy of this graph as it is now. The snapshot
+// shares my_csr and the descriptions instead of copying them. compile
+// never changes CSR arrays that are shared, so once an edge is 
+// inserted or removed here this graph builds new ones and the 
+// snapshot keeps the old version. The snapshot has no lists and no
+// computed rows, so taking one costs O(V) for the table, plus 
+// compiling if this graph is not compiled.
+// 
+// Preconditions: None.
+//		
+// Postconditions: The snapshot matches this graph. A mapped graph is
+//		   made a normal graph first, since its mapping can not
+//		   be shared.
+//====================================================================
+template <class W, class D>
+BasicGraph<W, D> BasicGraph<W, D>::snapshot ()
+{
+	BasicGraph copy;
+
+	if (my_mapping) materialize();
+	compile();
+
+	copy.my_size         = my_size;
+	copy.my_csr          = my_csr;
+	copy.my_compiled     = true;
+	copy.use_owned_csr();
+	copy.my_descriptions = my_descriptions;
+	copy.my_description_ids = my_description_ids;
+	copy.my_lazy         = my_lazy;
+	copy.my_strategy     = my_strategy;
+	copy.my_heap.setArity (my_heap.getArity());
+	copy.my_max_weight   = my_max_weight;
+	copy.my_max_weight_known = my_max_weight_known;
+	copy.my_threads      = my_threads;
+	copy.my_external_ids = my_external_ids;
+	copy.my_internal_ids = my_internal_ids;
+	copy.init_table();
+	return copy;
+}
+
+
+//========================isSnapshot==================================
+// Returns true if this graph is a snapshot that has not been changed.
+//====================================================================
+template <class W, class D>
+bool BasicGraph<W, D>::isSnapshot () const
+{
+	return my_vertices.empty() && my_size > 0 && my_mapping == NULL;
+}
+
+
+//========================isMapped====================================
+// Returns true if this graph is served from a file opened with 
+// openBinary.
+//====================================================================
+template <class W, class D>
+bool BasicGraph<W, D>::isMapped () const
+{
+	return my_mapping != NULL;
+}
+
+
+//========================unmap=======================================
+// Releases the file mapping, if any, and forgets the description 
+// views into it.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::unmap ()
+{
+	if (my_mapping) munmap (my_mapping, my_mapping_size);
+	my_mapping      = NULL;
+	my_mapping_size = 0;
+	my_desc_offsets = NULL;
+	my_desc_pool    = NULL;
+}
+
+
+//========================materialize=================================
+// Builds the adjacency lists and reverse lists from the CSR views,
+// interns the descriptions of a mapped graph, and copies the CSR 
+// arrays into this graph's own storage. The lists keep the CSR 
+// order, so the result is the graph that was saved. Afterwards the
+// graph no longer depends on the mapping, which is released.
+// 
+// Preconditions: my_size and the CSR and description views are set.
+//		
+// Postconditions: This graph is a normal, writable graph.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::materialize ()
+{
+	VertexNode empty;
+	EdgeNode *edge_node, *last;
+	const char *data;
+	int vertex, edge, length, edges;
+
+	empty.edgeHead    = NULL;
+	empty.reverseHead = NULL;
+	my_vertices.assign (my_size + 1, empty); // Not using index 0.
+
+	// Make room for everything in one slab.
+	edges = my_out_offsets [my_size + 1];
+	my_arena.reserve ((size_t) edges * 2 * sizeof (EdgeNode));
+
+	// A snapshot shares its descriptions already, so only the
+	// ones in a mapped file are interned.
+	if (my_desc_pool) {
+		my_descriptions    = make_shared<StringPool> ();
+		my_description_ids = make_shared< vector<int> > (my_size + 1, 0);
+		(*my_description_ids) [0] = my_descriptions->intern ("", 0);
+		for (vertex = 1; vertex <= my_size; vertex++) {
+			get_description (vertex, data, length);
+			(*my_description_ids) [vertex] = my_descriptions->intern (data, length);
+		}
+	}
+
+	for (vertex = 1; vertex <= my_size; vertex++) {
+		// Append the edges so the list keeps the CSR order.
+		last = NULL;
+		for (edge = my_out_offsets [vertex]; edge < my_out_offsets [vertex + 1]; edge++) {
+			edge_node = new_edge (my_out_targets [edge], my_out_weights [edge], NULL);
+			if (last == NULL)
+				my_vertices [vertex].edgeHead = edge_node;
+			else
+				last->nextEdge = edge_node;
+			last = edge_node;
+		}
+	}
+
+	// Mirror every edge into the reverse lists.
+	for (vertex = 1; vertex <= my_size; vertex++) {
+		for (edge_node = my_vertices [vertex].edgeHead; edge_node; 
+		     edge_node = edge_node->nextEdge)
+			link_reverse (vertex, edge_node->adjVertex, edge_node->weight);
+	}
+
+	// Keep the CSR arrays, but in storage of our own. The ones
+	// of a snapshot are already, and are copied on write.
+	if (!my_csr) {
+		my_csr = make_shared<CsrArrays> ();
+		my_csr->offsets.assign (my_out_offsets, my_out_offsets + my_size + 2);
+		my_csr->targets.assign (my_out_targets, my_out_targets + edges);
+		my_csr->weights.assign (my_out_weights, my_out_weights + edges);
+	}
+	unmap();
+	use_owned_csr();
+	my_compiled = true;
+
+	// insertEdge only raises my_max_weight, so it has to be known
+	// before the graph can change.
+	if (!my_max_weight_known) find_max_weight();
+}
+
+
+//========================get_description=============================
+// Sets the pointer and int to the description of the given vertex 
+// and its length, from the string pool of a mapped graph or from
+// my_descriptions. The description is not '\0' terminated.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::get_description (int the_vertex, const char *&the_data, 
+			     int &the_length) const
+{
+	if (my_desc_pool) {
+		the_data   = my_desc_pool + my_desc_offsets [the_vertex];
+		the_length = my_desc_offsets [the_vertex + 1] - 
+			     my_desc_offsets [the_vertex];
+	} else {
+		the_data   = my_descriptions->getData ((*my_description_ids) [the_vertex]);
+		the_length = my_descriptions->getLength ((*my_description_ids) [the_vertex]);
+	}
+}
+
+
+//========================write_description===========================
+// Sends the description of the given vertex to the output stream.
+//====================================================================
+template <class W, class D>
+void BasicGraph<W, D>::write_description (int the_vertex) const
+{
+	const char *data;
+	int length;
+
+	get_description (the_vertex, data, length);
+	cout.write (data, length);
 }
 
 
+// The weight and distance types of Graph, CompactGraph, LongGraph and
+// RealGraph.
+template class BasicGraph<int, int>;
+template class BasicGraph<unsigned short, int>;
+template class BasicGraph<unsigned int, long long>;
+template class BasicGraph<float, double>;
@@ -2,9 +2,16 @@
 // Graph.h 
 //  
 // This class represents a Graph that is implemented using an 
-// adjacency list. A graph can not have more than 100 edges. 
-// The entire graph can be displayed or a specific path can be 
+// adjacency list. Storage is sized from the number of vertices
+// read in buildGraph, so there is no fixed limit on the size of a
+// graph. The entire graph can be displayed or a specific path can be 
 // displayed. 
+//
+// It is a template on the type of the edge weights and the type of
+// the distances. Graph has int weights and distances; CompactGraph
+// keeps unsigned short weights in half the memory, LongGraph sums 
+// unsigned int weights into long long distances that do not 
+// overflow, and RealGraph has float weights and double distances.
 // 
 // Author: John Steele <steelejr@u.washington.edu> 
 // Date  : 2010/11/02
@@ -18,28 +25,106 @@
 //	- allows finding the shortest (lowest cost) path. 
 //	- allows displaying the graph.
 //	- allows dislplaying the graph from one vertex to another. 
+//	- allows compiling the adjacency lists into CSR arrays.
+//	- allows computing shortest paths lazily, one source at a 
+//	  time, as they are displayed.
+//	- allows choosing between a linear scan, a d-ary heap, a
+//	  bucket queue and a radix heap for selecting the next vertex
+//	  in Dijkstra's algorithm, or letting the density of the
+//	  graph and its largest edge weight decide.
+//	- allows finding all shortest paths on several threads.
+//	- allows saving a graph in a binary format, and opening it 
+//	  again by memory mapping the file.
+//	- allows finding a single shortest path with a bidirectional
+//	  search, or an A* search guided by a Heuristic, without 
+//	  computing the table.
+//	- allows finding the distances from a set of sources to a set
+//	  of targets without computing the whole table.
+//	- allows finding the vertices within a distance of a vertex,
+//	  or the k nearest to it.
+//	- allows moving, assigning and swapping graphs.
+//	- allows taking read-only snapshots that share the CSR arrays
+//	  with the graph until it changes.
+//	- allows reading a distance, a path or a shortest path tree
+//	  from the table into the caller's arrays instead of 
+//	  printing it.
+//	- allows renumbering the vertices internally in BFS, reverse
+//	  Cuthill-McKee or degree order, so neighbours sit close in
+//	  memory, while every method keeps taking and returning the
+//	  vertex numbers of the input.
+//	- allows descriptions of any length, each distinct one stored
+//	  once and shared by copies of the graph.
 // Assumptions:
 // 	- input is properly formatted. 
-//	- description of each vertex is no longer than 50 characters.
 //	- each line following the description contains three ints
 //	  representing an edge. 
 //	- a zero for the first integer signals the end of the data. 
+//	- the distance type is signed, so -1 can mean no path, and 
+//	  the types are one of the pairs Graph.cpp instantiates.
 //==================================================================== 
 
 #ifndef _GRAPH_H
 #define _GRAPH_H
-#include "Object.h" // Vertex data.
+#include "StringPool.h" // Vertex descriptions.
+#include "Heap.h"   // Dijkstra priority queue.
+#include "BucketQueue.h" // Dijkstra queue for small weights.
+#include "RadixHeap.h"   // Dijkstra queue for large weights.
+#include "Heuristic.h" // A* estimates.
+#include "Arena.h"  // EdgeNode storage.
+#include "Scheduler.h" // Parallel all-pairs.
 #include <iostream>  
 #include <iomanip>
 #include <fstream>
 #include <queue>
+#include <vector>
+#include <string>
+#include <thread>
+#include <memory>
+#include <limits>
 #include <limits.h>
+#include <type_traits>
 using namespace std;
 
-class Graph {   
+template <class W, class D>
+class BasicGraph {   
+
+	// Landmarks and ContractionHierarchy read the graph to 
+	// precompute their own data.
+	friend class Landmarks;
+	friend class ContractionHierarchy;
+
+	// Weights are read as ints, and a binary file stores them 
+	// in the space ints would take, rounded up.
+	static_assert (sizeof (W) <= sizeof (int), "W is wider than an int");
+	static_assert (numeric_limits<D>::is_signed, "D is not signed");
                          
 public:
 
+	// How run_dijkstra picks the next vertex to visit.
+	//	LINEAR_SCAN - scans every vertex, O(V^2) per source.
+	//	HEAP        - indexed d-ary heap, O((V+E) log V).
+	//	AUTO        - LINEAR_SCAN on a dense graph, otherwise
+	//		      DIAL if the largest weight is small and
+	//		      RADIX if not. The default, so the edges
+	//		      read by buildGraph pick the kernel.
+	//	DIAL        - Dial's bucket queue, O(V+E+D) where D is
+	//		      the largest distance. It needs a bucket
+	//		      per weight, so it runs RADIX if the 
+	//		      largest weight is over DIAL_LIMIT.
+	//	RADIX       - radix heap, O(E + V log C) where C is the
+	//		      largest weight.
+	enum Strategy { LINEAR_SCAN, HEAP, AUTO, DIAL, RADIX };
+
+	// How reorder numbers the vertices internally.
+	//	BFS_ORDER    - breadth first from vertex 1, and from the
+	//		       next vertex not reached for each other
+	//		       part of the graph.
+	//	RCM_ORDER    - reverse Cuthill-McKee: breadth first from
+	//		       a vertex of lowest degree, neighbours in
+	//		       order of degree, then reversed.
+	//	DEGREE_ORDER - the vertices with the most edges first.
+	enum Ordering { BFS_ORDER, RCM_ORDER, DEGREE_ORDER };
+
 	//========================Default-Constructor=================
 	// Creates a Graph object with default values. 
 	// 
@@ -48,7 +133,7 @@ public:
 	// Postconditions: this Graph object is instantiated with 
 	//    		   default values. 
 	//============================================================ 
-	Graph ();
+	BasicGraph ();
 
 
 	//========================Copy-Constructor====================
@@ -61,7 +146,49 @@ public:
 	// Postconditions: this Graph object is instantiated with
 	// 		   its data members set to the_other's. 
 	//============================================================ 
-	Graph (const Graph &);
+	BasicGraph (const BasicGraph &);
+
+
+	//========================Move-Constructor====================
+	// Creates a Graph object that takes over the_other's data
+	// without copying it.
+	// 
+	// Preconditions: None.
+	//		
+	// Postconditions: this Graph object holds what the_other 
+	//		   held, and the_other is empty.
+	//============================================================ 
+	BasicGraph (BasicGraph &&);
+
+
+	//========================operator============================
+	// Makes this graph a copy of the_other, the way the copy 
+	// constructor does.
+	// 
+	// Preconditions: None.
+	//		
+	// Postconditions: This graph's old data has been released.
+	//============================================================ 
+	BasicGraph &operator= (const BasicGraph &);
+
+
+	//========================operator============================
+	// Makes this graph take over the_other's data without 
+	// copying it.
+	// 
+	// Preconditions: None.
+	//		
+	// Postconditions: This graph's old data has been released, 
+	//		   and the_other is empty.
+	//============================================================ 
+	BasicGraph &operator= (BasicGraph &&);
+
+
+	//========================swap================================
+	// Exchanges the data of this graph and the_other. Nothing is
+	// copied.
+	//============================================================ 
+	void swap (BasicGraph &);
 
 
 	//========================Destructor==========================
@@ -71,7 +198,7 @@ public:
 	//		
 	// Postconditions: All resources have been released. 
 	//============================================================ 
-	~Graph ();
+	~BasicGraph ();
 
 
 	//========================buildGraph==========================
@@ -80,44 +207,69 @@ public:
 	// The format of the stream should be as follows: 
 	//	- The first line is the number of vertices.  
 	//	- Flollowing is a text description of each vertex.  
-	//	  (One description per line, and 50 chars max lenght)
+	//	  (One description per line, of any length)
 	//	- After that, each line has 3 ints rep. an edge. 
 	//	- A zero for the first int signals end of data. 
 	// 
+	// The stream is read in large blocks and the ints scanned by
+	// hand. The edges are linked in all at once and the shortest
+	// paths are found once at the end, or not at all in lazy mode.
+	// 
 	// Preconditions: The input must be properly formatted, and 
 	// 		  be organize as described above. 
 	//		
 	// Postconditions: The graph is built using the data from 
-	//		   the provided stream.
+	//		   the provided stream and true is returned. An
+	//		   edge with a vertex out of range or a weight 
+	//		   that is negative or does not fit W is skipped,
+	//		   and the rest are read. A line that can not be
+	//		   parsed stops the load, and the graph holds 
+	//		   what was read before it. Either way false is
+	//		   returned.
 	//============================================================ 
-	void buildGraph (ifstream &);
+	bool buildGraph (ifstream &);
+
+
+	//========================errorLine===========================
+	// Returns the line number of the line that stopped the last
+	// buildGraph, or else of the first edge it skipped, counted 
+	// from where it started reading, or zero if there was no 
+	// error.
+	//============================================================ 
+	int errorLine () const;
+
+
+	//========================errorMessage========================
+	// Returns what was wrong with the line given by errorLine, or
+	// an empty string if there was no error.
+	//============================================================ 
+	const char *errorMessage () const;
 
 
 	//========================insertEdge==========================
-	// Inserts an edge into this graph. Inserting this edge must 
-	// not exceed the max of 100 edges. The first int is the from
-	// vertex, the second is the to vertex, and the third int is
-	// the weight of the edge. 
+	// Inserts an edge into this graph. The first int is the from
+	// vertex, the second is the to vertex, and the W is the 
+	// weight of the edge. 
 	//
-	// If an edge is inserted, the findShortestPath method is ran
-	// to prevent a display of data that is not up to date.
+	// If an edge is inserted, or an existing edge's weight 
+	// changes, the computed rows of the table are repaired in 
+	// place so no data that is not up to date is displayed.
 	// 
-	// Preconditions: The vertices must exist in the graph. Adding
-	//		  the edge must not exceed the max edges of 	
-	//		  100. 
+	// Preconditions: The vertices must exist in the graph. 
 	//		
 	// Postconditions: Returns true if the edge was inserted into
 	//	 	   the graph, false otherwise.
 	//============================================================ 
-	bool insertEdge (int, int, int);
+	bool insertEdge (int, int, W);
 
 
 	//========================removeEdge==========================
 	// Removes an edge from the graph. The first provided int is
 	// the from vertex, and the second int is the to vertex.  
 	//		
-	// If an edge is removed, the findShortestPath method is ran
-	// to prevent a display of data that is not up to date.
+	// If an edge is removed, the computed rows of the table are
+	// repaired in place so no data that is not up to date is 
+	// displayed.
 	// 
 	// Preconditions: The edge must exist. The from vertex and to
 	// 		  vertex must exist.
@@ -147,7 +299,9 @@ public:
 	// Preconditions: The graph must have already built. 
 	//		
 	// Postconditions: A detailed graph is desplayed showing all
-	//		   the vertices, the edges, and weights. 
+	//		   the vertices, the edges, and weights. A path
+	//		   whose length does not fit in D is shown as no
+	//		   path, "--"; LongGraph has room for it.
 	//============================================================ 
 	void displayAll ();
 
@@ -167,18 +321,362 @@ public:
 	void display (int, int);
 
 
-private:
+	//========================findPath============================
+	// Finds the shortest path from the first int to the second 
+	// int with a bidirectional Dijkstra search: one search runs
+	// forward from the start over the edges, the other backward
+	// from the finish over the reverse edges, and they stop once 
+	// they meet. The table is not used or changed.
+	// 
+	// Preconditions: The graph is built.
+	//		
+	// Postconditions: Returns the length of the path, or -1 if
+	//		   there is none or a vertex does not exist. It
+	//		   is -1 too if the length does not fit in D,
+	//		   so use LongGraph for such weights.
+	//============================================================ 
+	D findPath (int, int);
+
+
+	//========================findPath============================
+	// Finds the shortest path from the first int to the second 
+	// int with an A* search guided by the Heuristic, such as 
+	// Landmarks. It is Dijkstra's algorithm from the start with
+	// each vertex keyed by its distance plus the estimate of the
+	// rest of the way, so vertices leading away from the finish
+	// are put off and mostly never visited. It stops when the 
+	// finish is visited. The table is not used or changed.
+	// 
+	// Preconditions: The graph is built, and the Heuristic is 
+	//		  admissible and consistent for it.
+	//		
+	// Postconditions: Returns the length of the path, or -1 if
+	//		   there is none, a vertex does not exist, or 
+	//		   the length does not fit in D.
+	//============================================================ 
+	D findPath (int, int, const Heuristic &);
+
+
+	//========================distanceMatrix======================
+	// Finds the distance from every source in the first vector to
+	// every target in the second, and stores them in the D 
+	// array row by row: the distance from sources[i] to 
+	// targets[j] goes at index i * targets.size() + j, and is -1
+	// if there is no path. A source whose row of the table is 
+	// computed is read from it. Otherwise Dijkstra's algorithm 
+	// runs from it until every target is visited, and the table
+	// is not changed.
+	// 
+	// Preconditions: The graph is built, and the array holds 
+	//		  sources.size() * targets.size() distances.
+	//		
+	// Postconditions: Returns false, and stores nothing, if a 
+	//		   vertex does not exist. A distance that does 
+	//		   not fit in D is stored as -1, like no path.
+	//============================================================ 
+	bool distanceMatrix (const vector<int> &, const vector<int> &, D *);
+
+
+	//========================findWithin==========================
+	// Finds every vertex whose distance from the int is at most
+	// the given radius, with Dijkstra's algorithm stopped once
+	// the next distance is past it. The table is not used or 
+	// changed.
+	// 
+	// Preconditions: The graph is built.
+	//		
+	// Postconditions: Returns the number of vertices found, the 
+	//		   first one included, or -1 if it does not 
+	//		   exist. getFound and getFoundDistances hold 
+	//		   them.
+	//============================================================ 
+	int findWithin (int, D);
+
+
+	//========================findNearest=========================
+	// Finds the vertices nearest to the first int, the first int
+	// included, up to the number given by the second int, with
+	// Dijkstra's algorithm stopped once that many are visited. 
+	// The table is not used or changed.
+	// 
+	// Preconditions: The graph is built.
+	//		
+	// Postconditions: Returns the number of vertices found, 
+	//		   fewer if not that many are reached, or -1 if 
+	//		   the first int does not exist. getFound and 
+	//		   getFoundDistances hold them.
+	//============================================================ 
+	int findNearest (int, int);
+
+
+	//========================getFound============================
+	// Returns the vertices found by the last findWithin or 
+	// findNearest, nearest first.
+	//============================================================ 
+	const vector<int> &getFound () const;
+
+
+	//========================getFoundDistances===================
+	// Returns the distances of the vertices in getFound, in the 
+	// same order.
+	//============================================================ 
+	const vector<D> &getFoundDistances () const;
+
+
+	//========================getSize=============================
+	// Returns the number of vertices. They are numbered from 1 to
+	// getSize.
+	//============================================================ 
+	int getSize () const;
+
+
+	//========================getDistance=========================
+	// Returns the length of the shortest path from the first int
+	// to the second int, computing the first int's row of the 
+	// table if it is not up to date.
+	// 
+	// Preconditions: The graph is built.
+	//		
+	// Postconditions: Returns -1 if there is no path or a vertex
+	//		   does not exist. It also returns -1 when the
+	//		   distance does not fit in D, since a longer
+	//		   path is not found; use LongGraph, whose long
+	//		   long distances hold any sum of its weights.
+	//============================================================ 
+	D getDistance (int, int);
+
+
+	//========================getPath=============================
+	// Stores the shortest path from the first int to the second
+	// int in the array, the first int first and the second int 
+	// last, computing the first int's row of the table if it is
+	// not up to date. The last int is how many ints the array 
+	// holds. Nothing is allocated, so it can be called as often 
+	// as needed once the row is computed.
+	// 
+	// Preconditions: The graph is built, and the array holds at
+	//		  least the last int ints.
+	//		
+	// Postconditions: Returns the number of vertices on the path,
+	//		   or -1 if there is none or a vertex does not 
+	//		   exist. A path whose length does not fit in D
+	//		   is not found either, and is -1 too. If the 
+	//		   path does not fit in the array, nothing is 
+	//		   stored and the number returned is the size 
+	//		   the array needs.
+	//============================================================ 
+	int getPath (int, int, int *, int);
+
+
+	//========================getPredecessors=====================
+	// Returns the shortest path tree from the given source, 
+	// computing its row of the table if it is not up to date. 
+	// Entry v of the getSize() + 1 ints is the vertex before v on
+	// its shortest path, the source for the source, and 0 if v 
+	// is not reached. Entry 0 is not used. It points into the 
+	// table, so nothing is copied, unless the graph is reordered
+	// and the tree has to be translated into a copy.
+	// 
+	// Preconditions: The graph is built.
+	//		
+	// Postconditions: Returns NULL if the source does not exist.
+	//		   The ints stay valid until the graph is changed
+	//		   or another graph is assigned to it.
+	//============================================================ 
+	const int *getPredecessors (int);
+
+
+	//========================settledCount========================
+	// Returns the number of vertices the last findPath, 
+	// distanceMatrix, findWithin or findNearest visited.
+	//============================================================ 
+	int settledCount () const;
+
+
+	//========================compile=============================
+	// Freezes the adjacency lists into compressed sparse row 
+	// (CSR) arrays that Dijkstra's algorithm walks linearly. It
+	// is done by buildGraph, and again by findShortestPath after
+	// an edge has been inserted or removed.
+	// 
+	// Preconditions: The graph is built.
+	//		
+	// Postconditions: The CSR arrays match the adjacency lists.
+	//============================================================ 
+	void compile ();
+
+
+	//========================isCompiled==========================
+	// Returns true if the CSR arrays match the adjacency lists.
+	//============================================================ 
+	bool isCompiled () const;
+
+
+	//========================reorder=============================
+	// Renumbers the vertices internally in the given order, so 
+	// the vertices near each other in the graph are near each 
+	// other in the CSR arrays and the rows of the table, and 
+	// Dijkstra's algorithm touches fewer cache lines. The edges 
+	// are treated as undirected to find the order. The numbers 
+	// from the input are kept: every method still takes and 
+	// returns them, and display prints them. The table is 
+	// cleared, and filled again in eager mode.
+	// 
+	// Preconditions: The graph is built.
+	//		
+	// Postconditions: The graph is unchanged except for where 
+	//		   its vertices are stored.
+	//============================================================ 
+	void reorder (Ordering);
+
+
+	//========================isReordered=========================
+	// Returns true if reorder has renumbered the vertices.
+	//============================================================ 
+	bool isReordered () const;
+
+
+	//========================saveBinary==========================
+	// Writes this graph to the named file in the binary format 
+	// read by openBinary: a header, the CSR arrays, and a pool of
+	// the vertex descriptions. Together with buildGraph this 
+	// converts the text format to the binary one. A reordered 
+	// graph is written in its internal order, with the numbers
+	// from the input.
+	// 
+	// Preconditions: The graph is built.
+	//		
+	// Postconditions: Returns true if the whole file was written,
+	//		   false otherwise.
+	//============================================================ 
+	bool saveBinary (const char *);
 
-	// Maximum number of vertices allowed in a graph. 
-	static const int MAX_VERTICES = 101; // Not using index 0.
+
+	//========================openBinary==========================
+	// Replaces this graph with the one in the named file, written
+	// by saveBinary. The file is memory mapped and queries read 
+	// the CSR arrays and descriptions straight from it, so the 
+	// graph is not parsed or copied. Open in lazy mode to keep 
+	// startup cheap. Inserting or removing an edge first turns 
+	// the mapped graph into a normal one.
+	//
+	// The header is always checked against the file. If the bool
+	// is true, the default, every array is checked too, in one 
+	// O(V+E) pass, so a corrupt file is refused. Opening is only 
+	// O(1) with openBinary (path, false), for a trusted file such
+	// as one just written by saveBinary.
+	// 
+	// Preconditions: The file was written by saveBinary on a 
+	//		  machine with the same int size and byte order.
+	//		  With the bool false, it is intact.
+	//		
+	// Postconditions: Returns true if the file was opened. Returns
+	//		   false and leaves the graph unchanged otherwise.
+	//		   A reordered graph opens reordered.
+	//============================================================ 
+	bool openBinary (const char *, bool = true);
 
 
+	//========================isMapped============================
+	// Returns true if this graph is served from a file opened 
+	// with openBinary.
+	//============================================================ 
+	bool isMapped () const;
+
+
+	//========================snapshot============================
+	// Returns a read-only copy of this graph as it is now. It 
+	// shares the CSR arrays with this graph instead of copying 
+	// them, and this graph builds new ones rather than change 
+	// them after an edge is inserted or removed, so the snapshot
+	// keeps seeing the old version. It has no adjacency lists and
+	// starts with no rows of the table computed. Inserting or 
+	// removing an edge in the snapshot makes it a normal graph,
+	// as for a mapped graph.
+	// 
+	// Preconditions: None.
+	//		
+	// Postconditions: The snapshot matches this graph. A mapped 
+	//		   graph is made a normal graph first, since its
+	//		   mapping can not be shared.
+	//============================================================ 
+	BasicGraph snapshot ();
+
+
+	//========================isSnapshot==========================
+	// Returns true if this graph is a snapshot that has not been
+	// changed.
+	//============================================================ 
+	bool isSnapshot () const;
+
+
+	//========================setLazy=============================
+	// Turns lazy mode on or off. In lazy mode, rows of the table
+	// are only computed when display or displayAll needs them, 
+	// and inserting or removing an edge only repairs the rows 
+	// already computed. Turning lazy mode off brings the whole
+	// table up to date.
+	// 
+	// Preconditions: None.
+	//		
+	// Postconditions: The graph is in the requested mode.
+	//============================================================ 
+	void setLazy (bool);
+
+
+	//========================isLazy==============================
+	// Returns true if the graph is in lazy mode.
+	//============================================================ 
+	bool isLazy () const;
+
+
+	//========================setStrategy=========================
+	// Selects how Dijkstra's algorithm picks the next vertex to
+	// visit, in place of the default AUTO. The int is the arity 
+	// of the heap, used by the HEAP strategy only. The table is 
+	// not recomputed.
+	// 
+	// Preconditions: None.
+	//		
+	// Postconditions: Later shortest path runs use the given 
+	//		   strategy.
+	//============================================================ 
+	void setStrategy (Strategy, int = 2);
+
+
+	//========================getStrategy=========================
+	// Returns the strategy used by Dijkstra's algorithm.
+	//============================================================ 
+	Strategy getStrategy () const;
+
+
+	//========================setThreadCount======================
+	// Sets the number of threads findShortestPath uses to compute
+	// all the rows of the table. Zero uses one thread per core,
+	// and one computes the rows serially.
+	// 
+	// Preconditions: None.
+	//		
+	// Postconditions: Later calls to findShortestPath use the 
+	//		   given number of threads.
+	//============================================================ 
+	void setThreadCount (int);
+
+
+	//========================getThreadCount======================
+	// Returns the number of threads used by findShortestPath.
+	//============================================================ 
+	int getThreadCount () const;
+
+
+private:
+
 	// A struct to represent an edge in the graph.
 	struct EdgeNode {		
 		// The subscript of the adjacent vertex. 
 		int adjVertex;     	
 		// The weight of the edge. 
-		int weight;      
+		W weight;      
 		// A link to the next edge.
   		EdgeNode *nextEdge;
 	};
@@ -188,39 +686,218 @@ private:
 	struct VertexNode {
 		// The head of the list of edges.
 		EdgeNode *edgeHead;		
-		// The vertex data.
-		Object *data;			
+		// The head of the list of edges coming into this vertex.
+		// Their adjVertex is the vertex the edge comes from.
+		EdgeNode *reverseHead;
 	};
 
 
-	// The array of VertexNodes in this graph.
-	VertexNode my_vertices [MAX_VERTICES];
+	// The line number and message of the last buildGraph error.
+	int my_error_line;
+	const char *my_error_message;
+
+
+	//========================set_error===========================
+	// Records the line number and message of a malformed line.
+	//============================================================ 
+	void set_error (int, const char *);
+
+
+	// The VertexNodes in this graph. Not using index 0.
+	vector<VertexNode> my_vertices;
 
 	// The number of vertices in this graph.
 	int my_size;				
 
+	// The EdgeNodes of this graph. They are all given back at
+	// once by delete_vertices.
+	Arena my_arena;
+
+	// Edges unlinked by removeEdge, chained by nextEdge, to be
+	// reused before the arena is asked for more.
+	EdgeNode *my_free_edges;
+
+
+	//========================new_edge============================
+	// Returns an EdgeNode to the vertex the int, with the given
+	// weight, linked to the given next edge.
+	//============================================================ 
+	EdgeNode *new_edge (int, W, EdgeNode *);
+
+
+	//========================free_edge===========================
+	// Keeps the given unlinked edge for new_edge to reuse.
+	//============================================================ 
+	void free_edge (EdgeNode *);
+
+
+	// The adjacency lists in compressed sparse row form. The 
+	// edges of vertex v are at indices offsets[v] up to 
+	// offsets[v + 1] of targets and weights.
+	struct CsrArrays {
+		vector<int> offsets;
+		vector<int> targets;
+		vector<W> weights;
+	};
+
+	// The CSR arrays built by compile. Copies and snapshots share
+	// them, so they are never changed while shared: compile 
+	// builds new ones instead.
+	shared_ptr<CsrArrays> my_csr;
+
+	// The CSR arrays the Dijkstra kernels read. They point into 
+	// my_csr, or into the file of a mapped graph.
+	const int *my_out_offsets;
+	const int *my_out_targets;
+	const W *my_out_weights;
+
+	// True if the CSR arrays match the adjacency lists.
+	bool my_compiled;
+
+
+	// The reverse lists in CSR form, for the backward search of
+	// findPath. The edges entering vertex v are at indices 
+	// my_in_offsets[v] up to my_in_offsets[v + 1] of my_in_sources
+	// and my_in_weights.
+	vector<int> my_in_offsets;
+	vector<int> my_in_sources;
+	vector<W> my_in_weights;
+
+	// True if the reverse CSR arrays match the CSR arrays.
+	bool my_reverse_compiled;
+
+
+	//========================compile_reverse=====================
+	// Compiles the graph if needed, then builds the reverse CSR
+	// arrays from the CSR arrays if they are stale. Building them
+	// from the CSR arrays also works for a mapped graph, which 
+	// has no reverse lists.
+	// 
+	// Preconditions: The graph is built.
+	//		
+	// Postconditions: The reverse CSR arrays match the graph.
+	//============================================================ 
+	void compile_reverse ();
+
+
+	// The first bytes of a file written by saveBinary.
+	static const char BINARY_MAGIC [9];
+
+	// The version of the binary format written by saveBinary.
+	static const int BINARY_VERSION = 1;
+
+	// The version of a file written by a reordered graph, which 
+	// also holds the input number of every vertex after the CSR
+	// arrays.
+	static const int BINARY_VERSION_IDS = 2;
+
+	// The start of a file written by saveBinary.
+	struct BinaryHeader {
+		// BINARY_MAGIC, without its '\0'.
+		char magic [8];
+		// BINARY_VERSION or BINARY_VERSION_IDS, plus 256 times
+		// weight_tag.
+		int version;
+		// The number of vertices.
+		int vertices;
+		// The number of edges.
+		int edges;
+		// The total length of the descriptions.
+		int pool_size;
+	};
+
+
+	//========================weight_tag==========================
+	// Returns the number that says what type the weights in a 
+	// binary file are: 0 for int, so those files are the same as
+	// before there were other types, and otherwise the size of W,
+	// plus 16 if it is signed and 32 if it is floating point.
+	//============================================================ 
+	static int weight_tag ();
+
+
+	//========================weights_bytes=======================
+	// Returns the bytes the given number of weights take in a 
+	// binary file, rounded up to whole ints so what follows them
+	// stays aligned.
+	//============================================================ 
+	static long long weights_bytes (long long);
+
+
+	//========================check_arrays========================
+	// Returns true if the CSR offsets, targets and weights, and 
+	// the description offsets, of a binary file with the int 
+	// number of vertices are all in bounds. The targets follow 
+	// the CSR offsets.
+	//============================================================ 
+	static bool check_arrays (const int *, const W *, const int *, int);
+
+	// The file mapping of a graph opened with openBinary, or NULL.
+	void *my_mapping;
+
+	// The length of my_mapping in bytes.
+	size_t my_mapping_size;
+
+	// The descriptions of a mapped graph, in the file's string
+	// pool. The description of vertex v is at my_desc_offsets[v]
+	// up to my_desc_offsets[v+1] of my_desc_pool. NULL when the
+	// graph is not mapped.
+	const int *my_desc_offsets;
+	const char *my_desc_pool;
+
+	// The descriptions of any other graph: each distinct one once
+	// in my_descriptions, and the int of the one of vertex v at 
+	// index v of my_description_ids. Descriptions never change 
+	// once the graph is built, so copies and snapshots share them
+	// instead of copying every string.
+	shared_ptr<StringPool> my_descriptions;
+	shared_ptr< vector<int> > my_description_ids;
+
+	// True if rows of the table are only computed when needed.
+	bool my_lazy;
+
+
+	// The distance of a vertex with no known path, the largest D.
+	static const D INFINITE;
+
+
+	//========================add_weight==========================
+	// Returns the distance plus the weight, or INFINITE if the 
+	// sum does not fit in a D. Only a D that is no more than 32
+	// bits wider than W needs the check; for a wider one, or a 
+	// floating point one, the test is a constant and compiles
+	// away.
+	//============================================================ 
+	static D add_weight (D, W);
 
-	// A table to store information for Dijkstra's algorithm
-	struct Table {
-		// A flag to mark if the  vertex has been visited.
-		bool isVisited;	
-		// The shortest known distance from source vertex.
-		int distance;
+	// The information Dijkstra's algorithm keeps for one source,
+	// one array per field. The minimum scan reads only distance 
+	// and the visited bits, and a relaxation only the distances
+	// and prev_vertex, instead of every field of every entry.
+	struct Row {
+		// The shortest known distance from the source vertex,
+		// INFINITE if there is none yet.
+		vector<D> distance;
 		// The previous vertex in optimal path from source.
-		int prev_vertex;
+		vector<int> prev_vertex;
+		// One bit per vertex, set once it has been visited.
+		vector<bool> visited;
 	};
 
 	// The table that stores: visited, distance, and path. 
-	// It's two dimensional in order to solve shortest path 	
-	// for all vertices in the graph.
-    	Table my_table [MAX_VERTICES][MAX_VERTICES];	
+	// It has one row per source vertex in order to solve shortest
+	// path for all vertices in the graph. A row is empty until 
+	// Dijkstra's algorithm is run from that source.
+	vector<Row> my_table;	
+
+	// The number of rows of the table that have been computed.
+	int my_rows_computed;
 
 
 	//========================init_table==========================
-	// Initializes the table of shortes paths.
-	// 	1.) Sets visited to false.
-	//	2.) Sets the initial distance to -1.
-	//	3.) Sets previous vertex to zero.
+	// Initializes the table of shortes paths. Sizes it to one 
+	// row per vertex and releases every row, so no source has 
+	// been solved yet.
 	// 
 	// Preconditions: None.
 	//		
@@ -229,12 +906,246 @@ private:
 	void init_table ();
 
 
+	//========================init_row============================
+	// Allocates the row of the table for the given source vertex
+	// if needed and initializes every entry of it.
+	// 	1.) Sets visited to false.
+	//	2.) Sets the initial distance to INFINITE.
+	//	3.) Sets previous vertex to zero.
+	// 
+	// Preconditions: The table has one row per vertex.
+	//		
+	// Postconditions: The row has been initialized.
+	//============================================================ 
+	void init_row (int);
+
+
+	//========================reset_row===========================
+	// Initializes every entry of the given source's row like 
+	// init_row, but does not count it as computed, so worker 
+	// threads can call it on rows of their own.
+	// 
+	// Preconditions: The table has one row per vertex.
+	//		
+	// Postconditions: The row has been initialized.
+	//============================================================ 
+	void reset_row (int);
+
+
+	//========================get_distance========================
+	// Returns the distance in the table from the first int to the
+	// second int, or -1 if there is no path or the row for the
+	// first int has not been computed.
+	//============================================================ 
+	D get_distance (int, int) const;
+
+
+	//========================resize_storage======================
+	// Grows my_vertices and my_table to hold the given number of
+	// vertices. Vertices that already exist are kept, new ones 
+	// have no description and no edges.
+	// 
+	// Preconditions: None.
+	//		
+	// Postconditions: Vertices 1 to the given int can be used.
+	//============================================================ 
+	void resize_storage (int);
+
+
+	// The strategy used by run_dijkstra.
+	Strategy my_strategy;
+
+	// A graph with at least V^2 / DENSE_DIVISOR edges is dense, 
+	// and AUTO, the default, runs the vectorized linear scan on it.
+	static const int DENSE_DIVISOR = 32;
+
+	// A graph whose largest weight is at most DIAL_LIMIT has so
+	// few buckets that AUTO runs the DIAL strategy on it. Past it
+	// the buckets would take too much memory, so DIAL runs RADIX.
+	static const int DIAL_LIMIT = 1024;
+
+	// The priority queue used by the HEAP strategy.
+	BasicHeap<D> my_heap;
+
+	// The key type of the bucket queue and radix heap. They only
+	// take integer keys, so for a floating point D this is a 
+	// stand in, and the DIAL and RADIX strategies run HEAP.
+	typedef typename conditional<numeric_limits<D>::is_integer, D,
+				     long long>::type QueueKey;
+
+	// The priority queues used by the DIAL and RADIX strategies.
+	BasicBucketQueue<QueueKey> my_buckets;
+	BasicRadixHeap<QueueKey> my_radix;
+
+	// No edge weighs more than this. Lowering or removing an edge
+	// leaves it as it was, so it may be more than the largest
+	// weight, never less.
+	W my_max_weight;
+
+	// False while my_max_weight has not been found yet, for a 
+	// graph opened with openBinary.
+	bool my_max_weight_known;
+
+
+	//========================find_max_weight=====================
+	// Sets my_max_weight from the CSR arrays, the first time a 
+	// mapped graph needs it.
+	//============================================================ 
+	void find_max_weight ();
+
+
+	// An edge read by buildGraph, waiting to be linked in.
+	struct StagedEdge {
+		// The from vertex.
+		int from;
+		// The to vertex.
+		int to;
+		// The weight of the edge.
+		int weight;
+	};
+
+
+	//========================bulk_insert=========================
+	// Links the staged edges into the adjacency lists in one 
+	// pass, with the same result as calling insertEdge on each
+	// edge in order but without the duplicate scan or shortest
+	// path work per edge. Linear in vertices plus edges.
+	// 
+	// Preconditions: The vertices exist and have no edges.
+	//		
+	// Postconditions: The adjacency lists hold the staged edges.
+	//		   The CSR arrays and table are not updated.
+	//============================================================ 
+	void bulk_insert (const vector<StagedEdge> &);
+
+
+	//========================is_valid_edge=======================
+	// Returns true if both vertices of the staged edge exist and
+	// its weight is not negative and a W holds it exactly.
+	//============================================================ 
+	bool is_valid_edge (const StagedEdge &) const;
+
+
+	//========================edge_decreased======================
+	// Called after the edge from the first int to the second int
+	// was inserted, or had its weight lowered to the given one.
+	// Marks the CSR arrays stale and repairs the computed rows.
+	// 
+	// Preconditions: The adjacency lists hold the new edge.
+	//		
+	// Postconditions: No stale distance can be displayed.
+	//============================================================ 
+	void edge_decreased (int, int, W);
+
+
+	//========================edge_increased======================
+	// Called after the edge from the first int to the second int
+	// was removed or had its weight raised. Marks the CSR arrays
+	// stale and repairs the computed rows.
+	// 
+	// Preconditions: The adjacency lists no longer hold the old
+	//		  edge.
+	//		
+	// Postconditions: No stale distance can be displayed.
+	//============================================================ 
+	void edge_increased (int, int);
+
+
+	//========================needs_full_update===================
+	// Runs findShortestPath and returns true if the graph is in
+	// eager mode but some rows were never computed, since those
+	// can not be repaired.
+	//============================================================ 
+	bool needs_full_update ();
+
+
+	//========================repair_decrease=====================
+	// Repairs the row of the source given by the first int after
+	// the edge from the second int to the third int got the 
+	// given (lower) weight.
+	// 
+	// Preconditions: The row is computed and was correct before
+	//		  the change.
+	//		
+	// Postconditions: The row for the source is correct.
+	//============================================================ 
+	void repair_decrease (int, int, int, W);
+
+
+	//========================repair_increase=====================
+	// Repairs the row of the source given by the first int after
+	// the edge from the second int to the third int was removed
+	// or made heavier. Only the subtree of the shortest path tree
+	// below the edge is recomputed.
+	// 
+	// Preconditions: The row is computed and was correct before
+	//		  the change.
+	//		
+	// Postconditions: The row for the source is correct.
+	//============================================================ 
+	void repair_increase (int, int, int);
+
+
+	//========================propagate===========================
+	// Settles the vertices in my_heap in order of distance, 
+	// relaxing the edges leaving each one, for the given source's
+	// row. Dijkstra's algorithm limited to the vertices whose 
+	// distance has just dropped.
+	// 
+	// Preconditions: my_heap holds the vertices whose distance
+	//		  dropped, keyed by their new distance.
+	//		
+	// Postconditions: The row for the source is correct.
+	//============================================================ 
+	void propagate (int);
+
+
+	//========================ensure_row==========================
+	// Runs Dijkstra's algorithm from the given source vertex if
+	// its row of the table is not up to date.
+	// 
+	// Preconditions: The given vertex exists.
+	//		
+	// Postconditions: The row for the given source is up to date.
+	//============================================================ 
+	void ensure_row (int);
+
+
+	// The number of threads used by findShortestPath.
+	int my_threads;
+
+
+	//========================run_parallel========================
+	// Runs Dijkstra's algorithm from every source on my_threads
+	// worker threads, balanced by a work-stealing Scheduler.
+	// 
+	// Preconditions: The CSR arrays are compiled and init_table
+	//		  has sized the table.
+	// 		  		
+	// Postconditions: Every row of the table has been computed.
+	//============================================================ 
+	void run_parallel ();
+
+
+	//========================run_worker==========================
+	// The body of one worker thread of run_parallel. It has its
+	// own queues and takes sources from the Scheduler until there
+	// are none left.
+	// 
+	// Preconditions: Same as run_parallel.
+	// 		  		
+	// Postconditions: The rows of every source taken are done.
+	//============================================================ 
+	void run_worker (Scheduler &, int);
+
+
 	//========================run_dijkstra========================
-	// Finds the shortest path for each of the vertices in the 
-	// graph to all the other vertices.
+	// Finds the shortest path from the given source vertex to all
+	// the other vertices using the selected strategy. The 
+	// source's row of the table is initialized first.
 	// 
 	// Preconditions: The graph is built and init_table is needed
-	//		  to initialize the table.
+	//		  to size the table.
 	// 		  		
 	// Postconditions: The shortest paths for each of the vertices
 	//		   in the graph have been found.
@@ -242,36 +1153,339 @@ private:
 	void run_dijkstra (int);
 
 
+	//========================solve_row===========================
+	// Runs the kernel for the selected strategy from the given
+	// source, using the given queues as scratch space.
+	// 
+	// Preconditions: The source's row has been initialized.
+	// 		  		
+	// Postconditions: The source's row holds its shortest paths.
+	//============================================================ 
+	void solve_row (int, BasicHeap<D> &, BasicBucketQueue<QueueKey> &,
+			BasicRadixHeap<QueueKey> &);
+
+
+	//========================run_linear_dijkstra=================
+	// Dijkstra's algorithm using find_and_visit_minimum to scan
+	// for the next vertex. O(V^2) per source.
+	// 
+	// Preconditions: Same as solve_row.
+	// 		  		
+	// Postconditions: Same as solve_row.
+	//============================================================ 
+	void run_linear_dijkstra (int);
+
+
+	//========================run_heap_dijkstra===================
+	// Dijkstra's algorithm using the given heap to pick the next
+	// vertex. O((V+E) log V) per source.
+	// 
+	// Preconditions: Same as solve_row.
+	// 		  		
+	// Postconditions: Same as solve_row.
+	//============================================================ 
+	void run_heap_dijkstra (int, BasicHeap<D> &);
+
+
+	//========================run_monotone_dijkstra===============
+	// Dijkstra's algorithm using the given BucketQueue or 
+	// RadixHeap, which has been reset, to pick the next vertex.
+	// 
+	// Preconditions: Same as solve_row.
+	// 		  		
+	// Postconditions: Same as solve_row.
+	//============================================================ 
+	template <class Queue>
+	void run_monotone_dijkstra (int, Queue &);
+
+
 	//========================find_and_vist_minimum===============
 	// Finds and returns the vertex with the minimum distance from
 	// the vertices that have not yet been visited within my_table
 	//
 	// It then marks the returned vertex as being visisted.
 	//
-	// Preconditions:  my_table needs to have all vertices that 
-	//		   have not been visisted set to false. 	
-	// 		   The distance of each vertex in my_table 
-	//		   need to be set to -1 if a distance has 
-	//		   not yet been assigned.
+	// Preconditions:  The vector holds the distance of every 
+	//		   vertex not visited yet, and INFINITE for the
+	//		   rest.
 	//		    	  		  		
 	// Postconditions: Returns the vertex with the shortest
 	//		   distance from the vertex that has not yet
-	//		   been visited.
+	//		   been visited, and sets its key to INFINITE.
+	//============================================================ 
+	int find_and_visit_minimum (int, vector<D> &);
+
+
+	//========================is_dense============================
+	// Returns true if the graph has enough edges for the linear
+	// scan to beat the heap.
+	//============================================================ 
+	bool is_dense () const;
+
+
+	// One direction of a findPath search. Only the vertices in 
+	// touched have been given a distance, so a search is reset by
+	// clearing those instead of every vertex.
+	struct Search {
+		// The shortest known distance, -1 if not reached yet.
+		vector<D> distance;
+		// The vertex before this one on the path found so far,
+		// the one after it for the backward search.
+		vector<int> parent;
+		// True once the distance is final.
+		vector<bool> settled;
+		// The vertices reached by the last search.
+		vector<int> touched;
+		// The vertices reached but not settled.
+		BasicHeap<D> heap;
+	};
+
+	// The forward and backward searches of findPath.
+	Search my_forward;
+	Search my_backward;
+
+	// The vertices of the last path found by findPath, in order.
+	vector<int> my_path;
+
+	// The number of vertices the last findPath, distanceMatrix,
+	// findWithin or findNearest visited.
+	int my_settled;
+
+	// The vertices found by the last findWithin or findNearest,
+	// nearest first, and their distances.
+	vector<int> my_found;
+	vector<D> my_found_distances;
+
+
+	//========================start_search========================
+	// Clears the given search and starts it from the given 
+	// vertex.
+	//============================================================ 
+	void start_search (Search &, int);
+
+
+	//========================reach===============================
+	// Gives the vertex the first int the given distance in the
+	// given search, with the last int as its parent.
+	//============================================================ 
+	void reach (Search &, int, D, int);
+
+
+	//========================settle_next=========================
+	// Settles the vertex at the top of the first search's heap
+	// and relaxes its edges in the given CSR arrays. Any edge 
+	// that reaches a vertex the second search has reached joins
+	// the two into a path; the best so far is kept in the D
+	// (its length, -1 if none) and the two vertices joined by 
+	// the edge, in forward order.
 	//============================================================ 
-	int find_and_visit_minimum (int);
+	void settle_next (Search &, Search &, const int *, const int *, 
+			  const W *, bool, D &, int &, int &);
 
 
-	//========================display_helper======================
-	// A recursive helper method for displaying shortest paths.
+	//========================search_bounded======================
+	// Runs Dijkstra's algorithm from the first int with 
+	// my_forward, stopping before a vertex farther than the 
+	// given radius or once the last int vertices are visited, and
+	// keeps the visited vertices in my_found.
+	//============================================================ 
+	void search_bounded (int, D, int);
+
+
+	//========================trace_path==========================
+	// Sets my_path to the path the forward search found from its
+	// source to the given vertex, in internal vertices.
+	//============================================================ 
+	void trace_path (int);
+
+
+	//========================distances_from======================
+	// Runs Dijkstra's algorithm from the given vertex, forward 
+	// over the edges if the bool is true and backward over the 
+	// reverse edges otherwise, and sets the vector to the 
+	// distance of every vertex, -1 if it is not reached. Used by
+	// Landmarks. The vertex and the vector use the numbers from 
+	// the input.
+	//============================================================ 
+	void distances_from (int, bool, vector<D> &);
+
+
+	//========================display_path========================
+	// Prints the given path, with the given length, the way 
+	// display prints a path from the table. The path holds the 
+	// numbers from the input. Also used by ContractionHierarchy.
+	//============================================================ 
+	void display_path (const vector<int> &, D) const;
+
+
+	//========================table_path==========================
+	// Sets my_path to the path from the first int to the second
+	// int in the first int's row of the table, in the numbers 
+	// from the input.
 	// 
-	// Preconditions:  my_table is up to date. Otherwise the 
-	//		   path might not print correctly. 
-	// 		  		
-	// Postconditions: The shortest path from the_source to 
-	//		   the_last has been printed to the output
-	//		   stream. 
+	// Preconditions: The row is up to date and the second vertex
+	//		  is reachable from the first.
 	//============================================================ 
-	void display_helper (int, int, int);
+	void table_path (int, int);
+
+
+	// The path displayAll printed last in a row, kept so the next
+	// path only walks back to where the two meet.
+	struct PathPrefix {
+		// The vertices of the path, the source first.
+		vector<int> vertices;
+		// The length of text up to and including each vertex.
+		vector<int> ends;
+		// Where each vertex is in vertices, -1 if not on it.
+		vector<int> position;
+		// The vertices walked over by extend_prefix.
+		vector<int> walked;
+		// The path as it is printed, vertices between spaces.
+		string text;
+	};
+
+
+	//========================start_prefix========================
+	// Makes the given source the whole path of the PathPrefix.
+	// 
+	// Preconditions: position has an entry per vertex.
+	//============================================================ 
+	void start_prefix (PathPrefix &, int);
+
+
+	//========================extend_prefix=======================
+	// Changes the path of the PathPrefix to the path from the 
+	// first int to the second int in the first int's row of the
+	// table, reusing the part it shares with the current path.
+	// 
+	// Preconditions: The row is up to date, the second vertex is
+	//		  reachable from the first, and the PathPrefix 
+	//		  was started from the first.
+	//============================================================ 
+	void extend_prefix (PathPrefix &, int, int);
+
+
+	// The number from the input of each internal vertex, and the
+	// internal vertex of each number from the input, for a graph 
+	// reorder has renumbered. Both are empty otherwise, and index
+	// 0 is not used.
+	vector<int> my_external_ids;
+	vector<int> my_internal_ids;
+
+	// The tree getPredecessors returns for a reordered graph, 
+	// translated to the numbers from the input.
+	vector<int> my_predecessors;
+
+
+	//========================internal_id=========================
+	// Returns the internal vertex of the given number from the
+	// input.
+	//============================================================ 
+	int internal_id (int) const;
+
+
+	//========================external_id=========================
+	// Returns the number from the input of the given internal 
+	// vertex.
+	//============================================================ 
+	int external_id (int) const;
+
+
+	//========================to_external=========================
+	// Replaces every internal vertex in the vector with its 
+	// number from the input.
+	//============================================================ 
+	void to_external (vector<int> &) const;
+
+
+	//========================order_vertices======================
+	// Sets the vector to the internal vertices in the given 
+	// order, not using index 0.
+	// 
+	// Preconditions: The reverse CSR arrays are compiled.
+	//============================================================ 
+	void order_vertices (Ordering, vector<int> &);
+
+
+	//========================relabel=============================
+	// Moves the vertex at index i of the vector to internal 
+	// vertex i, renaming the ends of every edge and updating 
+	// my_external_ids and my_internal_ids to match.
+	// 
+	// Preconditions: The graph has its adjacency lists, and the
+	//		  vector holds every vertex once.
+	//============================================================ 
+	void relabel (const vector<int> &);
+
+
+	//========================use_owned_csr=======================
+	// Points my_out_offsets, my_out_targets and my_out_weights at
+	// my_csr.
+	//============================================================ 
+	void use_owned_csr ();
+
+
+	//========================unmap===============================
+	// Releases the file mapping, if any, and forgets the 
+	// description views into it.
+	//============================================================ 
+	void unmap ();
+
+
+	//========================materialize=========================
+	// Builds the adjacency lists, and the descriptions from the
+	// string pool of a mapped graph, takes a copy of the CSR arrays 
+	// unless they are in my_csr already, and releases the 
+	// mapping.
+	// 
+	// Preconditions: my_size and the CSR and description views 
+	//		  are set.
+	//		
+	// Postconditions: This graph is a normal, writable graph.
+	//============================================================ 
+	void materialize ();
+
+
+	//========================get_description=====================
+	// Sets the pointer and int to the description of the given
+	// vertex and its length. It is not '\0' terminated.
+	//============================================================ 
+	void get_description (int, const char *&, int &) const;
+
+
+	//========================write_description===================
+	// Sends the description of the given vertex to the output 
+	// stream.
+	//============================================================ 
+	void write_description (int) const;
+
+
+	//========================copy_list===========================
+	// Returns a copy of the given list of edges, in order.
+	//============================================================ 
+	EdgeNode *copy_list (const EdgeNode *);
+
+
+	//========================unlink_edge=========================
+	// Removes the edge to the given vertex from the list with the
+	// given head, and returns it, or NULL if there is none.
+	//============================================================ 
+	static EdgeNode *unlink_edge (EdgeNode *&, int);
+
+
+	//========================find_edge===========================
+	// Returns the edge to the given vertex in the list with the
+	// given head, or NULL if there is none.
+	//============================================================ 
+	static EdgeNode *find_edge (EdgeNode *, int);
+
+
+	//========================link_reverse========================
+	// Adds the edge from the first int to the second int, with
+	// the given weight, to the second vertex's reverse list.
+	//============================================================ 
+	void link_reverse (int, int, W);
+
 
 	//========================delete_vertices=====================
 	// A helper method for the deconstructor. It deletes all 
@@ -281,19 +1495,15 @@ private:
 	//		  in the graph.
 	//		  		  		
 	// Postconditions: All dynamic memory has been deleted from 	
-	//		   my_vertices.
+	//		   my_vertices, and the graph is empty.
 	//============================================================ 
 	void delete_vertices (); 
-	
-	//========================print_vertices======================
-	// A helper method for displaying the descriptions of	
-	// vertices.
-	// 
-	// Preconditions: my_table is up to data.
-	//		  		  		
-	// Postconditions: The descriptions are printed to output.
-	//============================================================ 
-	void print_vertices (int, int, int); 
 };
+
+// The graphs Graph.cpp instantiates.
+typedef BasicGraph<int, int> Graph;
+typedef BasicGraph<unsigned short, int> CompactGraph;
+typedef BasicGraph<unsigned int, long long> LongGraph;
+typedef BasicGraph<float, double> RealGraph;
 #endif /* _GRAPH_H */
 
@@ -0,0 +1,176 @@
+//====================================================================
+// GraphGenerator.cpp
+//
+// This class makes random graphs and writes them in the text format
+// read by Graph::buildGraph. It is used by the bench programs to
+// make inputs of any size that come out the same for the same seed.
+//====================================================================
+// GraphGenerator class:
+//   Includes following features:
+// 	- allows making a graph with random edges between random
+//	  vertices.
+//	- allows making a grid graph, like a road network, with its
+//	  vertices numbered in row order or shuffled.
+//	- allows writing the graph to a file.
+//	- allows drawing more random numbers from the same seed.
+// Assumptions:
+// 	- the graphs fit in memory twice over, once as edges here and
+//	  once in the Graph that reads them.
+//====================================================================
+
+#include "GraphGenerator.h"
+#include <fstream>
+#include <algorithm>
+
+
+//========================Constructor=================================
+// Creates a GraphGenerator whose random numbers start from the given
+// seed.
+//
+// Preconditions: None.
+//
+// Postconditions: No graph has been made yet.
+//====================================================================
+GraphGenerator::GraphGenerator (unsigned the_seed)
+	: my_random (the_seed), my_size (0) {}
+
+
+//========================makeRandom==================================
+// Makes a graph with the first int vertices and the second int edges,
+// each from a random vertex to another random vertex, with a random
+// weight from 1 to the third int.
+//
+// Preconditions: There is at least one vertex, and the largest weight
+//		  is at least 1.
+//
+// Postconditions: The graph replaces the last one made.
+//====================================================================
+void GraphGenerator::makeRandom (int the_size, int the_edges, int the_max_weight)
+{
+	Edge edge;
+	int i;
+
+	my_size = the_size;
+	my_edges.clear();
+	my_edges.reserve (the_edges);
+
+	for (i = 0; i < the_edges; i++) {
+		edge.from   = nextInt (1, my_size);
+		edge.to     = nextInt (1, my_size);
+		edge.weight = nextInt (1, the_max_weight);
+		my_edges.push_back (edge);
+	}
+}
+
+
+//========================makeGrid====================================
+// Makes a graph of the first int rows by the second int columns of
+// vertices, each with an edge each way to the vertices beside, above
+// and below it, with a random weight from 1 to the third int. If the
+// bool is true the vertices are numbered in a random order, otherwise
+// row by row.
+//
+// Preconditions: There is at least one row and one column, and the
+//		  largest weight is at least 1.
+//
+// Postconditions: The graph replaces the last one made.
+//====================================================================
+void GraphGenerator::makeGrid (int the_rows, int the_columns,
+			       int the_max_weight, bool the_shuffle)
+{
+	vector<int> number;
+	Edge edge;
+	int row, column, cell;
+
+	my_size = the_rows * the_columns;
+	my_edges.clear();
+	my_edges.reserve ((size_t) my_size * 4);
+
+	// The number given to each cell, counted row by row.
+	number.resize (my_size);
+	for (cell = 0; cell < my_size; cell++) number [cell] = cell + 1;
+	if (the_shuffle) shuffle (number.begin(), number.end(), my_random);
+
+	for (row = 0; row < the_rows; row++) {
+		for (column = 0; column < the_columns; column++) {
+			cell = row * the_columns + column;
+			if (column + 1 < the_columns) {
+				edge.from   = number [cell];
+				edge.to     = number [cell + 1];
+				edge.weight = nextInt (1, the_max_weight);
+				my_edges.push_back (edge);
+				std::swap (edge.from, edge.to);
+				my_edges.push_back (edge);
+			}
+			if (row + 1 < the_rows) {
+				edge.from   = number [cell];
+				edge.to     = number [cell + the_columns];
+				edge.weight = nextInt (1, the_max_weight);
+				my_edges.push_back (edge);
+				std::swap (edge.from, edge.to);
+				my_edges.push_back (edge);
+			}
+		}
+	}
+}
+
+
+//========================write=======================================
+// Writes the graph to the named file in the text format, one
+// description per vertex and a line of zeros at the end.
+//
+// Preconditions: A graph has been made.
+//
+// Postconditions: Returns true if the whole file was written, false
+//		   otherwise.
+//====================================================================
+bool GraphGenerator::write (const char *the_path) const
+{
+	ofstream outfile (the_path, ios::out | ios::trunc);
+	int vertex, i;
+
+	if (!outfile) return false;
+
+	outfile << my_size << '\n';
+	for (vertex = 1; vertex <= my_size; vertex++)
+		outfile << "Vertex " << vertex << '\n';
+	for (i = 0; i < (int) my_edges.size(); i++) {
+		outfile << my_edges [i].from << ' ' << my_edges [i].to << ' '
+			<< my_edges [i].weight << '\n';
+	}
+	outfile << "0 0 0\n";
+
+	outfile.close();
+	return !outfile.fail();
+}
+
+
+//========================getSize=====================================
+// Returns the number of vertices of the graph.
+//====================================================================
+int GraphGenerator::getSize () const
+{
+	return my_size;
+}
+
+
+//========================getEdges====================================
+// Returns the edges of the graph in the order they are written.
+//====================================================================
+const vector<GraphGenerator::Edge> &GraphGenerator::getEdges () const
+{
+	return my_edges;
+}
+
+
+//========================nextInt=====================================
+// Returns a random int from the first int to the second int, both
+// included, from the same sequence the graphs are made from.
+//
+// Preconditions: The first int is not past the second.
+//====================================================================
+int GraphGenerator::nextInt (int the_low, int the_high)
+{
+	uniform_int_distribution<int> range (the_low, the_high);
+	return range (my_random);
+}
@@ -0,0 +1,128 @@
+//====================================================================
+// GraphGenerator.h
+//
+// This class makes random graphs and writes them in the text format
+// read by Graph::buildGraph. It is used by the bench programs to
+// make inputs of any size that come out the same for the same seed.
+//====================================================================
+// GraphGenerator class:
+//   Includes following features:
+// 	- allows making a graph with random edges between random
+//	  vertices.
+//	- allows making a grid graph, like a road network, with its
+//	  vertices numbered in row order or shuffled.
+//	- allows writing the graph to a file.
+//	- allows drawing more random numbers from the same seed.
+// Assumptions:
+// 	- the graphs fit in memory twice over, once as edges here and
+//	  once in the Graph that reads them.
+//====================================================================
+
+#ifndef _GRAPHGENERATOR_H
+#define _GRAPHGENERATOR_H
+#include <random>
+#include <vector>
+using namespace std;
+
+class GraphGenerator {
+
+public:
+
+	// An edge of the generated graph.
+	struct Edge {
+		// The vertices it goes from and to, numbered from 1.
+		int from;
+		int to;
+		// Its weight, not negative.
+		int weight;
+	};
+
+
+	//========================Constructor=========================
+	// Creates a GraphGenerator whose random numbers start from
+	// the given seed.
+	//
+	// Preconditions: None.
+	//
+	// Postconditions: No graph has been made yet.
+	//============================================================
+	GraphGenerator (unsigned);
+
+
+	//========================makeRandom==========================
+	// Makes a graph with the first int vertices and the second
+	// int edges, each from a random vertex to another random
+	// vertex, with a random weight from 1 to the third int. Two
+	// edges may join the same vertices, and then the last one
+	// read wins.
+	//
+	// Preconditions: There is at least one vertex, and the
+	//		  largest weight is at least 1.
+	//
+	// Postconditions: The graph replaces the last one made.
+	//============================================================
+	void makeRandom (int, int, int);
+
+
+	//========================makeGrid============================
+	// Makes a graph of the first int rows by the second int
+	// columns of vertices, each with an edge each way to the
+	// vertices beside, above and below it, with a random weight
+	// from 1 to the third int. If the bool is true the vertices
+	// are numbered in a random order, so neighbours in the grid
+	// are far apart in the numbering, otherwise row by row.
+	//
+	// Preconditions: There is at least one row and one column,
+	//		  and the largest weight is at least 1.
+	//
+	// Postconditions: The graph replaces the last one made.
+	//============================================================
+	void makeGrid (int, int, int, bool);
+
+
+	//========================write===============================
+	// Writes the graph to the named file in the text format, one
+	// description per vertex and a line of zeros at the end.
+	//
+	// Preconditions: A graph has been made.
+	//
+	// Postconditions: Returns true if the whole file was written,
+	//		   false otherwise.
+	//============================================================
+	bool write (const char *) const;
+
+
+	//========================getSize=============================
+	// Returns the number of vertices of the graph.
+	//============================================================
+	int getSize () const;
+
+
+	//========================getEdges============================
+	// Returns the edges of the graph in the order they are
+	// written.
+	//============================================================
+	const vector<Edge> &getEdges () const;
+
+
+	//========================nextInt=============================
+	// Returns a random int from the first int to the second int,
+	// both included, from the same sequence the graphs are made
+	// from.
+	//
+	// Preconditions: The first int is not past the second.
+	//============================================================
+	int nextInt (int, int);
+
+private:
+
+	// The source of the random numbers.
+	mt19937 my_random;
+
+	// The number of vertices of the graph.
+	int my_size;
+
+	// The edges of the graph.
+	vector<Edge> my_edges;
+};
+#endif /* _GRAPHGENERATOR_H */
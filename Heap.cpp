@@ -0,0 +1,274 @@
+//====================================================================
+// Heap.cpp
+//
+// This class represents an indexed d-ary min heap of vertices keyed
+// by their tentative distance. It is used by Graph.h to select the
+// next vertex to visit in Dijkstra's algorithm. It is a template on
+// the type of the keys, the distance type of the graph, and Heap is
+// the one with int keys.
+//====================================================================
+// Heap class:
+//   Includes following features:
+// 	- allows choosing the arity (children per node) of the heap.
+//	- allows pushing a vertex with a key.
+//	- allows decreasing the key of a vertex already in the heap.
+//	- allows looking at and popping the vertex with the minimum
+//	  key.
+// Assumptions:
+// 	- vertices are numbered 1 to the capacity given to reset.
+//	- a vertex is in the heap at most once.
+//	- the keys are int, long long or double, the types Heap.cpp 
+//	  instantiates it for.
+//====================================================================
+
+#include "Heap.h"
+
+
+//========================Constructor=================================
+// Creates an empty Heap with the given arity. An arity less than 2 is
+// treated as 2 (a binary heap).
+//
+// Preconditions: None.
+//
+// Postconditions: This Heap is empty and holds no vertices.
+//====================================================================
+template <class K>
+BasicHeap<K>::BasicHeap (int the_arity) : my_arity (2), my_count (0)
+{
+	setArity (the_arity);
+}
+
+
+//========================setArity====================================
+// Sets the number of children of each node in the heap. Any vertices
+// already in the heap are discarded.
+//
+// Preconditions: None.
+//
+// Postconditions: The heap is empty and uses the new arity.
+//====================================================================
+template <class K>
+void BasicHeap<K>::setArity (int the_arity)
+{
+	my_arity = (the_arity < 2) ? 2 : the_arity;
+	reset ((int) my_position.size() - 1);
+}
+
+
+//========================getArity====================================
+// Returns the number of children of each node in the heap.
+//====================================================================
+template <class K>
+int BasicHeap<K>::getArity () const
+{
+	return my_arity;
+}
+
+
+//========================reset=======================================
+// Empties the heap and makes room for vertices numbered 1 to the
+// given capacity.
+//
+// A Dijkstra run pops every vertex it pushes, so my_position is
+// normally all -1 already and only the leftovers need clearing.
+//
+// Preconditions: None.
+//
+// Postconditions: The heap is empty and vertices up to the capacity
+//		   can be pushed.
+//====================================================================
+template <class K>
+void BasicHeap<K>::reset (int the_capacity)
+{
+	int i;
+
+	// Forget anything left over from the last run.
+	for (i = 0; i < my_count; i++)
+		my_position [my_vertex [i]] = -1;
+	my_count = 0;
+
+	// Not using index 0.
+	if (the_capacity + 1 > (int) my_position.size()) {
+		my_position.resize (the_capacity + 1, -1);
+		my_vertex.resize (the_capacity + 1);
+		my_key.resize (the_capacity + 1);
+	}
+}
+
+
+//========================isEmpty=====================================
+// Returns true if the heap holds no vertices.
+//====================================================================
+template <class K>
+bool BasicHeap<K>::isEmpty () const
+{
+	return my_count == 0;
+}
+
+
+//========================contains====================================
+// Returns true if the given vertex is in the heap.
+//====================================================================
+template <class K>
+bool BasicHeap<K>::contains (int the_vertex) const
+{
+	return my_position [the_vertex] != -1;
+}
+
+
+//========================push========================================
+// Inserts the int (a vertex) with the given key.
+//
+// Preconditions: The vertex is within the capacity and not already in
+//		  the heap.
+//
+// Postconditions: The vertex is in the heap.
+//====================================================================
+template <class K>
+void BasicHeap<K>::push (int the_vertex, K the_key)
+{
+	place (my_count, the_vertex, the_key);
+	my_count++;
+	sift_up (my_count - 1);
+}
+
+
+//========================decreaseKey=================================
+// Lowers the key of the int (a vertex) to the given key and restores
+// the heap order.
+//
+// Preconditions: The vertex is in the heap and the new key is not
+//		  greater than its current key.
+//
+// Postconditions: The vertex has the new key.
+//====================================================================
+template <class K>
+void BasicHeap<K>::decreaseKey (int the_vertex, K the_key)
+{
+	int index = my_position [the_vertex];
+	my_key [index] = the_key;
+	sift_up (index);
+}
+
+
+//========================top=========================================
+// Returns the vertex with the minimum key without removing it.
+//
+// Preconditions: The heap is not empty.
+//====================================================================
+template <class K>
+int BasicHeap<K>::top () const
+{
+	return my_vertex [0];
+}
+
+
+//========================topKey======================================
+// Returns the minimum key in the heap.
+//
+// Preconditions: The heap is not empty.
+//====================================================================
+template <class K>
+K BasicHeap<K>::topKey () const
+{
+	return my_key [0];
+}
+
+
+//========================pop=========================================
+// Removes and returns the vertex with the minimum key.
+//
+// Preconditions: The heap is not empty.
+//
+// Postconditions: The vertex is no longer in the heap.
+//====================================================================
+template <class K>
+int BasicHeap<K>::pop ()
+{
+	int vertex = my_vertex [0];
+
+	my_position [vertex] = -1;
+	my_count--;
+
+	// Move the last entry to the root and push it down.
+	if (my_count > 0) {
+		place (0, my_vertex [my_count], my_key [my_count]);
+		sift_down (0);
+	}
+	return vertex;
+}
+
+
+//========================sift_up=====================================
+// Moves the entry at the given heap index up until its parent's key
+// is not greater than its own.
+//====================================================================
+template <class K>
+void BasicHeap<K>::sift_up (int the_index)
+{
+	int vertex = my_vertex [the_index];
+	K key      = my_key [the_index];
+	int parent;
+
+	while (the_index > 0) {
+		parent = (the_index - 1) / my_arity;
+		if (my_key [parent] <= key) break;
+
+		// Pull the parent down into the hole.
+		place (the_index, my_vertex [parent], my_key [parent]);
+		the_index = parent;
+	}
+	place (the_index, vertex, key);
+}
+
+
+//========================sift_down===================================
+// Moves the entry at the given heap index down until none of its
+// children have a smaller key.
+//====================================================================
+template <class K>
+void BasicHeap<K>::sift_down (int the_index)
+{
+	int vertex = my_vertex [the_index];
+	K key      = my_key [the_index];
+	int first, last, child, best;
+
+	for (;;) {
+		first = the_index * my_arity + 1;
+		if (first >= my_count) break;
+		last = first + my_arity;
+		if (last > my_count) last = my_count;
+
+		// Find the smallest child.
+		best = first;
+		for (child = first + 1; child < last; child++) {
+			if (my_key [child] < my_key [best])
+				best = child;
+		}
+		if (my_key [best] >= key) break;
+
+		// Pull the child up into the hole.
+		place (the_index, my_vertex [best], my_key [best]);
+		the_index = best;
+	}
+	place (the_index, vertex, key);
+}
+
+
+//========================place=======================================
+// Stores the vertex and key at the given heap index and records the
+// index in my_position.
+//====================================================================
+template <class K>
+void BasicHeap<K>::place (int the_index, int the_vertex, K the_key)
+{
+	my_vertex [the_index]     = the_vertex;
+	my_key [the_index]        = the_key;
+	my_position [the_vertex]  = the_index;
+}
+
+
+// The key types of the graphs Graph.cpp instantiates.
+template class BasicHeap<int>;
+template class BasicHeap<long long>;
+template class BasicHeap<double>;
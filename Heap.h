@@ -0,0 +1,175 @@
+//====================================================================
+// Heap.h
+//
+// This class represents an indexed d-ary min heap of vertices keyed
+// by their tentative distance. It is used by Graph.h to select the
+// next vertex to visit in Dijkstra's algorithm. It is a template on
+// the type of the keys, the distance type of the graph, and Heap is
+// the one with int keys.
+//====================================================================
+// Heap class:
+//   Includes following features:
+// 	- allows choosing the arity (children per node) of the heap.
+//	- allows pushing a vertex with a key.
+//	- allows decreasing the key of a vertex already in the heap.
+//	- allows looking at and popping the vertex with the minimum
+//	  key.
+// Assumptions:
+// 	- vertices are numbered 1 to the capacity given to reset.
+//	- a vertex is in the heap at most once.
+//	- the keys are int, long long or double, the types Heap.cpp 
+//	  instantiates it for.
+//====================================================================
+
+#ifndef _HEAP_H
+#define _HEAP_H
+#include <vector>
+using namespace std;
+
+template <class K>
+class BasicHeap {
+
+public:
+
+	//========================Constructor=========================
+	// Creates an empty Heap with the given arity. An arity less
+	// than 2 is treated as 2 (a binary heap).
+	//
+	// Preconditions: None.
+	//
+	// Postconditions: This Heap is empty and holds no vertices.
+	//============================================================
+	BasicHeap (int = 2);
+
+
+	//========================setArity============================
+	// Sets the number of children of each node in the heap. Any
+	// vertices already in the heap are discarded.
+	//
+	// Preconditions: None.
+	//
+	// Postconditions: The heap is empty and uses the new arity.
+	//============================================================
+	void setArity (int);
+
+
+	//========================getArity============================
+	// Returns the number of children of each node in the heap.
+	//============================================================
+	int getArity () const;
+
+
+	//========================reset===============================
+	// Empties the heap and makes room for vertices numbered 1 to
+	// the given capacity.
+	//
+	// Preconditions: None.
+	//
+	// Postconditions: The heap is empty and vertices up to the
+	//		   capacity can be pushed.
+	//============================================================
+	void reset (int);
+
+
+	//========================isEmpty=============================
+	// Returns true if the heap holds no vertices.
+	//============================================================
+	bool isEmpty () const;
+
+
+	//========================contains============================
+	// Returns true if the given vertex is in the heap.
+	//============================================================
+	bool contains (int) const;
+
+
+	//========================push================================
+	// Inserts the int (a vertex) with the given key.
+	//
+	// Preconditions: The vertex is within the capacity and not
+	//		  already in the heap.
+	//
+	// Postconditions: The vertex is in the heap.
+	//============================================================
+	void push (int, K);
+
+
+	//========================decreaseKey=========================
+	// Lowers the key of the int (a vertex) to the given key and
+	// restores the heap order.
+	//
+	// Preconditions: The vertex is in the heap and the new key is
+	//		  not greater than its current key.
+	//
+	// Postconditions: The vertex has the new key.
+	//============================================================
+	void decreaseKey (int, K);
+
+
+	//========================top=================================
+	// Returns the vertex with the minimum key without removing it.
+	//
+	// Preconditions: The heap is not empty.
+	//============================================================
+	int top () const;
+
+
+	//========================topKey==============================
+	// Returns the minimum key in the heap.
+	//
+	// Preconditions: The heap is not empty.
+	//============================================================
+	K topKey () const;
+
+
+	//========================pop=================================
+	// Removes and returns the vertex with the minimum key.
+	//
+	// Preconditions: The heap is not empty.
+	//
+	// Postconditions: The vertex is no longer in the heap.
+	//============================================================
+	int pop ();
+
+private:
+
+	//========================sift_up=============================
+	// Moves the entry at the given heap index up until its
+	// parent's key is not greater than its own.
+	//============================================================
+	void sift_up (int);
+
+
+	//========================sift_down===========================
+	// Moves the entry at the given heap index down until none of
+	// its children have a smaller key.
+	//============================================================
+	void sift_down (int);
+
+
+	//========================place===============================
+	// Stores the vertex and key at the given heap index and
+	// records the index in my_position.
+	//============================================================
+	void place (int, int, K);
+
+
+	// The number of children of each node.
+	int my_arity;
+
+	// The number of vertices in the heap.
+	int my_count;
+
+	// The vertices in heap order.
+	vector<int> my_vertex;
+
+	// The keys, parallel to my_vertex.
+	vector<K> my_key;
+
+	// The heap index of each vertex, -1 if not in the heap.
+	vector<int> my_position;
+};
+
+// The heap used with int distances.
+typedef BasicHeap<int> Heap;
+#endif /* _HEAP_H */
@@ -0,0 +1,26 @@
+//====================================================================
+// Heuristic.cpp
+//
+// This class represents an estimate of the shortest distance from a
+// vertex to a target vertex. It is used by Graph.h to guide an A*
+// search toward the target. Subclasses supply the estimate.
+//====================================================================
+// Heuristic class:
+//   Includes following features:
+// 	- allows estimating the distance from a vertex to a target.
+// Assumptions:
+// 	- the estimate never exceeds the real distance (admissible).
+//	- the estimate for a vertex never exceeds the weight of an edge
+//	  leaving it plus the estimate for the edge's end (consistent),
+//	  so A* never has to visit a vertex twice.
+//====================================================================
+
+#include "Heuristic.h"
+
+
+//========================Destructor==================================
+// Releases the resources of a subclass.
+//====================================================================
+Heuristic::~Heuristic ()
+{
+}
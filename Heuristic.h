@@ -0,0 +1,42 @@
+//====================================================================
+// Heuristic.h
+//
+// This class represents an estimate of the shortest distance from a
+// vertex to a target vertex. It is used by Graph.h to guide an A*
+// search toward the target. Subclasses supply the estimate.
+//====================================================================
+// Heuristic class:
+//   Includes following features:
+// 	- allows estimating the distance from a vertex to a target.
+// Assumptions:
+// 	- the estimate never exceeds the real distance (admissible).
+//	- the estimate for a vertex never exceeds the weight of an edge
+//	  leaving it plus the estimate for the edge's end (consistent),
+//	  so A* never has to visit a vertex twice.
+//====================================================================
+
+#ifndef _HEURISTIC_H
+#define _HEURISTIC_H
+
+class Heuristic {
+
+public:
+
+	//========================Destructor==========================
+	// Releases the resources of a subclass.
+	//============================================================
+	virtual ~Heuristic ();
+
+
+	//========================estimate============================
+	// Returns a lower bound on the shortest distance from the
+	// first int to the second int. Both are vertices.
+	//
+	// Preconditions: Both vertices exist.
+	//
+	// Postconditions: Returns a number from 0 up to the real
+	//		   distance.
+	//============================================================
+	virtual int estimate (int, int) const = 0;
+};
+#endif /* _HEURISTIC_H */
@@ -0,0 +1,158 @@
+//====================================================================
+// Landmarks.cpp
+//
+// This class represents the ALT heuristic (A*, landmarks, triangle
+// inequality). A few vertices are chosen as landmarks and the
+// shortest distances from and to each of them are stored. Because
+// d(L, t) <= d(L, v) + d(v, t) and d(v, L) <= d(v, t) + d(t, L) for
+// any landmark L, the differences d(L, t) - d(L, v) and
+// d(v, L) - d(t, L) are lower bounds on d(v, t). It is used with
+// Graph::findPath.
+//====================================================================
+// Landmarks class:
+//   Includes following features:
+// 	- allows choosing landmarks that are far apart and computing
+//	  the distances from and to each of them.
+//	- allows estimating the distance from a vertex to a target.
+// Assumptions:
+// 	- the graph is not changed after build, otherwise build has to
+//	  be run again before the estimates can be trusted.
+//====================================================================
+
+#include "Landmarks.h"
+#include <limits.h> // INT_MAX, LLONG_MAX
+
+
+//========================Default-Constructor=========================
+// Creates Landmarks with no landmarks. Every estimate is 0 until
+// build is run.
+//
+// Preconditions: None.
+//
+// Postconditions: There are no landmarks.
+//====================================================================
+Landmarks::Landmarks () : my_count (0), my_size (0)
+{
+}
+
+
+//========================build=======================================
+// Chooses the given number of landmarks in the graph and computes the
+// shortest distances from and to each of them.
+//
+// The first landmark is the vertex farthest from vertex 1. Each one
+// after it is the vertex whose round trip to the nearest landmark
+// already chosen is longest. A vertex with no round trip at all
+// scores highest, so every part of a graph that is not strongly
+// connected gets a landmark of its own if there are enough.
+//
+// Preconditions: The graph is built.
+//
+// Postconditions: There are min(count, vertices) landmarks.
+//====================================================================
+void Landmarks::build (Graph &the_graph, int the_count)
+{
+	vector<int> from, to;
+	vector<long long> score;
+	long long trip;
+	int landmark, vertex, k;
+
+	my_size  = the_graph.my_size;
+	my_count = (the_count < my_size) ? the_count : my_size;
+	if (my_count < 0) my_count = 0;
+	my_landmarks.clear();
+	my_from.assign ((my_size + 1) * my_count, -1); // Not using vertex 0.
+	my_to.assign ((my_size + 1) * my_count, -1);
+	if (my_count == 0) return;
+
+	// Start from the vertex farthest from vertex 1.
+	the_graph.distances_from (1, true, from);
+	landmark = 1;
+	for (vertex = 1; vertex <= my_size; vertex++) {
+		if (from [vertex] > from [landmark])
+			landmark = vertex;
+	}
+
+	score.assign (my_size + 1, LLONG_MAX);
+	for (k = 0; k < my_count; k++) {
+		my_landmarks.push_back (landmark);
+		the_graph.distances_from (landmark, true, from);
+		the_graph.distances_from (landmark, false, to);
+
+		for (vertex = 1; vertex <= my_size; vertex++) {
+			my_from [vertex * my_count + k] = from [vertex];
+			my_to [vertex * my_count + k]   = to [vertex];
+
+			// Score the vertex by its shortest round trip to a
+			// landmark, counting a missing path as INT_MAX.
+			trip = (long long) (from [vertex] == -1 ? INT_MAX : from [vertex]) +
+			       (to [vertex] == -1 ? INT_MAX : to [vertex]);
+			if (trip < score [vertex])
+				score [vertex] = trip;
+		}
+
+		// The next landmark is the vertex scored highest.
+		landmark = 1;
+		for (vertex = 2; vertex <= my_size; vertex++) {
+			if (score [vertex] > score [landmark])
+				landmark = vertex;
+		}
+	}
+}
+
+
+//========================getCount====================================
+// Returns the number of landmarks.
+//====================================================================
+int Landmarks::getCount () const
+{
+	return my_count;
+}
+
+
+//========================getLandmark=================================
+// Returns the vertex that is the given landmark, counting from 0.
+//====================================================================
+int Landmarks::getLandmark (int the_index) const
+{
+	return my_landmarks [the_index];
+}
+
+
+//========================estimate====================================
+// Returns the largest of the lower bounds on the distance from the
+// first int to the second int given by the landmarks, or 0 if none
+// of them gives one. A landmark only gives a bound if both of the
+// distances it uses exist.
+//
+// Preconditions: Both vertices exist.
+//
+// Postconditions: Returns a number from 0 up to the real distance.
+//====================================================================
+int Landmarks::estimate (int the_vertex, int the_target) const
+{
+	const int *from_vertex, *from_target, *to_vertex, *to_target;
+	int best = 0;
+	int k;
+
+	if (my_count == 0 || the_vertex > my_size || the_target > my_size) 
+		return 0;
+
+	from_vertex = &my_from [0] + the_vertex * my_count;
+	from_target = &my_from [0] + the_target * my_count;
+	to_vertex   = &my_to [0] + the_vertex * my_count;
+	to_target   = &my_to [0] + the_target * my_count;
+
+	for (k = 0; k < my_count; k++) {
+		// d(L, t) - d(L, v)
+		if (from_vertex [k] != -1 && from_target [k] != -1 &&
+		    from_target [k] - from_vertex [k] > best)
+			best = from_target [k] - from_vertex [k];
+
+		// d(v, L) - d(t, L)
+		if (to_vertex [k] != -1 && to_target [k] != -1 &&
+		    to_vertex [k] - to_target [k] > best)
+			best = to_vertex [k] - to_target [k];
+	}
+	return best;
+}
@@ -0,0 +1,100 @@
+//====================================================================
+// Landmarks.h
+//
+// This class represents the ALT heuristic (A*, landmarks, triangle
+// inequality). A few vertices are chosen as landmarks and the
+// shortest distances from and to each of them are stored. Because
+// d(L, t) <= d(L, v) + d(v, t) and d(v, L) <= d(v, t) + d(t, L) for
+// any landmark L, the differences d(L, t) - d(L, v) and
+// d(v, L) - d(t, L) are lower bounds on d(v, t). It is used with
+// Graph::findPath.
+//====================================================================
+// Landmarks class:
+//   Includes following features:
+// 	- allows choosing landmarks that are far apart and computing
+//	  the distances from and to each of them.
+//	- allows estimating the distance from a vertex to a target.
+// Assumptions:
+// 	- the graph is not changed after build, otherwise build has to
+//	  be run again before the estimates can be trusted.
+//====================================================================
+
+#ifndef _LANDMARKS_H
+#define _LANDMARKS_H
+#include "Heuristic.h"
+#include "Graph.h"
+#include <vector>
+using namespace std;
+
+class Landmarks : public Heuristic {
+
+public:
+
+	//========================Default-Constructor=================
+	// Creates Landmarks with no landmarks. Every estimate is 0
+	// until build is run.
+	//
+	// Preconditions: None.
+	//
+	// Postconditions: There are no landmarks.
+	//============================================================
+	Landmarks ();
+
+
+	//========================build===============================
+	// Chooses the given number of landmarks in the graph and
+	// computes the shortest distances from and to each of them.
+	// Each landmark is the vertex farthest from the ones already
+	// chosen, so they end up spread around the edge of the graph
+	// where their bounds are tightest.
+	//
+	// Preconditions: The graph is built.
+	//
+	// Postconditions: There are min(count, vertices) landmarks.
+	//============================================================
+	void build (Graph &, int);
+
+
+	//========================getCount============================
+	// Returns the number of landmarks.
+	//============================================================
+	int getCount () const;
+
+
+	//========================getLandmark=========================
+	// Returns the vertex that is the given landmark, counting
+	// from 0.
+	//============================================================
+	int getLandmark (int) const;
+
+
+	//========================estimate============================
+	// Returns the largest of the lower bounds on the distance
+	// from the first int to the second int given by the
+	// landmarks, or 0 if none of them gives one.
+	//
+	// Preconditions: Both vertices exist.
+	//
+	// Postconditions: Returns a number from 0 up to the real
+	//		   distance.
+	//============================================================
+	virtual int estimate (int, int) const;
+
+private:
+
+	// The number of landmarks.
+	int my_count;
+
+	// The number of vertices in the graph they were built for.
+	int my_size;
+
+	// The vertices chosen as landmarks.
+	vector<int> my_landmarks;
+
+	// The distances from and to each landmark, -1 if there is no
+	// path. The ones for vertex v are at v * my_count up to
+	// (v + 1) * my_count, so an estimate reads two short runs.
+	vector<int> my_from;
+	vector<int> my_to;
+};
+#endif /* _LANDMARKS_H */
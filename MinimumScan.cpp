@@ -0,0 +1,243 @@
+//====================================================================
+// MinimumScan.cpp
+//
+// This class finds the position of the smallest int in an array, the
+// inner loop of the O(V^2) Dijkstra's algorithm in Graph.h. On x86
+// processors with SSE4.1 or AVX2 it compares 4 or 8 ints at a time;
+// which version runs is decided once, the first time it is used, by
+// asking the processor what it supports.
+//====================================================================
+// MinimumScan class:
+//   Includes following features:
+// 	- allows finding the first position of the smallest int in a
+//	  range of an array.
+//	- allows knowing which version of the scan is used.
+//	- allows finding the smallest long long or double the same
+//	  way, one at a time.
+// Assumptions:
+// 	- the compiler is GCC or Clang for the vector versions, any
+//	  other compiler or processor gets the plain loop.
+//====================================================================
+
+#include "MinimumScan.h"
+
+// The vector versions are compiled for their instruction set one
+// function at a time, so the rest of the program still runs on any
+// x86 processor.
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define MINIMUMSCAN_VECTOR
+#include <immintrin.h>
+#endif
+
+
+//========================find========================================
+// Returns the position of the smallest int in the array from the
+// first int up to but not including the second int, the first of
+// them if several are smallest.
+//
+// Preconditions: The first int is less than the second.
+//
+// Postconditions: None.
+//====================================================================
+int MinimumScan::find (const int *the_keys, int the_first, int the_last)
+{
+	static const Kind kind = detect();
+	return find_with (kind, the_keys, the_first, the_last);
+}
+
+
+//========================find========================================
+// The plain loop for keys of another type. A later key only wins if
+// it is strictly smaller, so the first of the smallest is kept.
+//====================================================================
+template <class K>
+int MinimumScan::find (const K *the_keys, int the_first, int the_last)
+{
+	int i, best = the_first;
+
+	for (i = the_first + 1; i < the_last; i++) {
+		if (the_keys [i] < the_keys [best])
+			best = i;
+	}
+	return best;
+}
+
+
+//========================getKind=====================================
+// Returns the version of the scan find uses.
+//====================================================================
+MinimumScan::Kind MinimumScan::getKind ()
+{
+	static const Kind kind = detect();
+	return kind;
+}
+
+
+//========================find_with===================================
+// Runs the given version of the scan, which the processor must
+// support.
+//====================================================================
+int MinimumScan::find_with (Kind the_kind, const int *the_keys,
+			    int the_first, int the_last)
+{
+	switch (the_kind) {
+	case AVX2: return find_avx2 (the_keys, the_first, the_last);
+	case SSE4: return find_sse4 (the_keys, the_first, the_last);
+	default:   return find_scalar (the_keys, the_first, the_last);
+	}
+}
+
+
+//========================detect======================================
+// Returns the best version the processor supports.
+//====================================================================
+MinimumScan::Kind MinimumScan::detect ()
+{
+#ifdef MINIMUMSCAN_VECTOR
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports ("avx2"))   return AVX2;
+	if (__builtin_cpu_supports ("sse4.1")) return SSE4;
+#endif
+	return SCALAR;
+}
+
+
+//========================find_scalar=================================
+// The plain loop. A later int only wins if it is strictly smaller,
+// so the first of the smallest is kept.
+//====================================================================
+int MinimumScan::find_scalar (const int *the_keys, int the_first,
+			      int the_last)
+{
+	int i, best = the_first;
+
+	for (i = the_first + 1; i < the_last; i++) {
+		if (the_keys [i] < the_keys [best])
+			best = i;
+	}
+	return best;
+}
+
+
+#ifdef MINIMUMSCAN_VECTOR
+
+//========================find_sse4===================================
+// Keeps the smallest int seen in each of 4 lanes, and its position.
+// A lane only takes a strictly smaller int, so it keeps the first of
+// its smallest. The lanes are then combined, taking the smallest
+// position among those holding the smallest int, and the last few
+// ints are checked one at a time.
+//====================================================================
+__attribute__ ((target ("sse4.1")))
+int MinimumScan::find_sse4 (const int *the_keys, int the_first,
+			    int the_last)
+{
+	int values [4], positions [4];
+	int i, lane, best;
+	__m128i best_values, best_positions, current, step, keys, smaller;
+
+	if (the_last - the_first < 8)
+		return find_scalar (the_keys, the_first, the_last);
+
+	best_values    = _mm_loadu_si128 ((const __m128i *) (the_keys + the_first));
+	best_positions = _mm_setr_epi32 (the_first, the_first + 1,
+					 the_first + 2, the_first + 3);
+	current        = best_positions;
+	step           = _mm_set1_epi32 (4);
+
+	for (i = the_first + 4; i + 4 <= the_last; i += 4) {
+		current = _mm_add_epi32 (current, step);
+		keys    = _mm_loadu_si128 ((const __m128i *) (the_keys + i));
+		smaller = _mm_cmpgt_epi32 (best_values, keys);
+		best_values    = _mm_min_epi32 (best_values, keys);
+		best_positions = _mm_blendv_epi8 (best_positions, current, smaller);
+	}
+
+	_mm_storeu_si128 ((__m128i *) values, best_values);
+	_mm_storeu_si128 ((__m128i *) positions, best_positions);
+	best = positions [0];
+	for (lane = 1; lane < 4; lane++) {
+		if (values [lane] < the_keys [best] ||
+		    (values [lane] == the_keys [best] && positions [lane] < best))
+			best = positions [lane];
+	}
+	for (; i < the_last; i++) {
+		if (the_keys [i] < the_keys [best])
+			best = i;
+	}
+	return best;
+}
+
+
+//========================find_avx2===================================
+// The same as find_sse4 with 8 lanes.
+//====================================================================
+__attribute__ ((target ("avx2")))
+int MinimumScan::find_avx2 (const int *the_keys, int the_first,
+			    int the_last)
+{
+	int values [8], positions [8];
+	int i, lane, best;
+	__m256i best_values, best_positions, current, step, keys, smaller;
+
+	if (the_last - the_first < 16)
+		return find_scalar (the_keys, the_first, the_last);
+
+	best_values    = _mm256_loadu_si256 ((const __m256i *) (the_keys + the_first));
+	best_positions = _mm256_setr_epi32 (the_first, the_first + 1,
+					    the_first + 2, the_first + 3,
+					    the_first + 4, the_first + 5,
+					    the_first + 6, the_first + 7);
+	current        = best_positions;
+	step           = _mm256_set1_epi32 (8);
+
+	for (i = the_first + 8; i + 8 <= the_last; i += 8) {
+		current = _mm256_add_epi32 (current, step);
+		keys    = _mm256_loadu_si256 ((const __m256i *) (the_keys + i));
+		smaller = _mm256_cmpgt_epi32 (best_values, keys);
+		best_values    = _mm256_min_epi32 (best_values, keys);
+		best_positions = _mm256_blendv_epi8 (best_positions, current, smaller);
+	}
+
+	_mm256_storeu_si256 ((__m256i *) values, best_values);
+	_mm256_storeu_si256 ((__m256i *) positions, best_positions);
+	best = positions [0];
+	for (lane = 1; lane < 8; lane++) {
+		if (values [lane] < the_keys [best] ||
+		    (values [lane] == the_keys [best] && positions [lane] < best))
+			best = positions [lane];
+	}
+	for (; i < the_last; i++) {
+		if (the_keys [i] < the_keys [best])
+			best = i;
+	}
+	return best;
+}
+
+#else
+
+//========================find_sse4===================================
+// Not available, so the plain loop.
+//====================================================================
+int MinimumScan::find_sse4 (const int *the_keys, int the_first,
+			    int the_last)
+{
+	return find_scalar (the_keys, the_first, the_last);
+}
+
+
+//========================find_avx2===================================
+// Not available, so the plain loop.
+//====================================================================
+int MinimumScan::find_avx2 (const int *the_keys, int the_first,
+			    int the_last)
+{
+	return find_scalar (the_keys, the_first, the_last);
+}
+
+#endif
+
+
+// The distance types of the graphs Graph.cpp instantiates.
+template int MinimumScan::find (const long long *, int, int);
+template int MinimumScan::find (const double *, int, int);
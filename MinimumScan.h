@@ -0,0 +1,95 @@
+//====================================================================
+// MinimumScan.h
+//
+// This class finds the position of the smallest int in an array, the
+// inner loop of the O(V^2) Dijkstra's algorithm in Graph.h. On x86
+// processors with SSE4.1 or AVX2 it compares 4 or 8 ints at a time;
+// which version runs is decided once, the first time it is used, by
+// asking the processor what it supports.
+//====================================================================
+// MinimumScan class:
+//   Includes following features:
+// 	- allows finding the first position of the smallest int in a
+//	  range of an array.
+//	- allows knowing which version of the scan is used.
+//	- allows finding the smallest long long or double the same
+//	  way, one at a time.
+// Assumptions:
+// 	- the compiler is GCC or Clang for the vector versions, any
+//	  other compiler or processor gets the plain loop.
+//====================================================================
+
+#ifndef _MINIMUMSCAN_H
+#define _MINIMUMSCAN_H
+
+class MinimumScan {
+
+public:
+
+	// The versions of the scan.
+	//	SCALAR - one int at a time.
+	//	SSE4   - 4 ints at a time.
+	//	AVX2   - 8 ints at a time.
+	enum Kind { SCALAR, SSE4, AVX2 };
+
+
+	//========================find================================
+	// Returns the position of the smallest int in the array from
+	// the first int up to but not including the second int. If
+	// several are smallest the first of them is returned, so
+	// every version gives the same answer.
+	//
+	// Preconditions: The first int is less than the second.
+	//
+	// Postconditions: None.
+	//============================================================
+	static int find (const int *, int, int);
+
+
+	//========================find================================
+	// The same for keys of another type, such as the long long
+	// and double distances of the graphs in Graph.h, with the
+	// plain loop only.
+	//============================================================
+	template <class K>
+	static int find (const K *, int, int);
+
+
+	//========================getKind=============================
+	// Returns the version of the scan find uses.
+	//============================================================
+	static Kind getKind ();
+
+
+	//========================find_with===========================
+	// Runs the given version of the scan, which the processor
+	// must support.
+	//============================================================
+	static int find_with (Kind, const int *, int, int);
+
+private:
+
+	//========================find_scalar=========================
+	// The plain loop.
+	//============================================================
+	static int find_scalar (const int *, int, int);
+
+
+	//========================find_sse4===========================
+	// The scan 4 ints at a time.
+	//============================================================
+	static int find_sse4 (const int *, int, int);
+
+
+	//========================find_avx2===========================
+	// The scan 8 ints at a time.
+	//============================================================
+	static int find_avx2 (const int *, int, int);
+
+
+	//========================detect==============================
+	// Returns the best version the processor supports.
+	//============================================================
+	static Kind detect ();
+};
+#endif /* _MINIMUMSCAN_H */
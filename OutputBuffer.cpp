@@ -0,0 +1,181 @@
+//====================================================================
+// OutputBuffer.cpp
+//
+// This class represents a buffer that formats text in memory and
+// sends it to an output stream in large writes. It is used by
+// Graph.h to print the table in displayAll, which prints V^2 lines:
+// going through the stream's formatting for every field, and
+// flushing after every line, takes far longer than finding the
+// paths.
+//====================================================================
+// OutputBuffer class:
+//   Includes following features:
+// 	- allows writing characters, text and numbers, right aligned
+//	  in a field like setw does.
+//	- allows flushing the buffer to the stream.
+// Assumptions:
+// 	- nothing else writes to the stream until the buffer has
+//	  been flushed, so the output stays in order.
+//====================================================================
+
+#include "OutputBuffer.h"
+#include <string.h> // memcpy, strlen
+#include <stdio.h>  // snprintf
+
+
+//========================Constructor=================================
+// Creates an OutputBuffer that writes to the given stream whenever
+// the int number of characters have been buffered.
+//
+// Preconditions: The stream outlives the buffer.
+//
+// Postconditions: The buffer is empty.
+//====================================================================
+OutputBuffer::OutputBuffer (ostream &the_stream, int the_capacity)
+	: my_stream (the_stream), my_buffer (the_capacity < 64 ? 64 : the_capacity),
+	  my_used (0)
+{
+}
+
+
+//========================Destructor==================================
+// Flushes what is left in the buffer.
+//====================================================================
+OutputBuffer::~OutputBuffer ()
+{
+	flush();
+}
+
+
+//========================put=========================================
+// Appends the given character.
+//====================================================================
+void OutputBuffer::put (char the_char)
+{
+	reserve (1);
+	my_buffer [my_used++] = the_char;
+}
+
+
+//========================fill========================================
+// Appends the given character the int number of times.
+//====================================================================
+void OutputBuffer::fill (char the_char, int the_count)
+{
+	while (the_count > 0) {
+		reserve (1);
+		my_buffer [my_used++] = the_char;
+		the_count--;
+	}
+}
+
+
+//========================write=======================================
+// Appends the int number of characters starting at the given pointer.
+// Text longer than the whole buffer is written straight through.
+//====================================================================
+void OutputBuffer::write (const char *the_text, int the_length)
+{
+	if (the_length > (int) my_buffer.size()) {
+		flush();
+		my_stream.write (the_text, the_length);
+		return;
+	}
+	reserve (the_length);
+	memcpy (&my_buffer [my_used], the_text, the_length);
+	my_used += the_length;
+}
+
+
+//========================writeText===================================
+// Appends the given '\0' terminated text, padded on the left with
+// spaces to the int width, like setw does.
+//====================================================================
+void OutputBuffer::writeText (const char *the_text, int the_width)
+{
+	int length = (int) strlen (the_text);
+
+	fill (' ', the_width - length);
+	write (the_text, length);
+}
+
+
+//========================writeNumber=================================
+// Appends the int, padded on the left with spaces to the given width.
+//====================================================================
+void OutputBuffer::writeNumber (int the_value, int the_width)
+{
+	writeNumber ((long long) the_value, the_width);
+}
+
+
+//========================writeNumber=================================
+// Appends the long long in decimal, padded on the left with spaces to
+// the int width. The digits are made from the last one back, into a
+// small array that fits any long long.
+//====================================================================
+void OutputBuffer::writeNumber (long long the_value, int the_width)
+{
+	char digits [21];
+	int first = sizeof (digits);
+	unsigned long long value = (the_value < 0) ? 
+		0ull - (unsigned long long) the_value : (unsigned long long) the_value;
+
+	do {
+		digits [--first] = (char) ('0' + value % 10);
+		value /= 10;
+	} while (value != 0);
+	if (the_value < 0) digits [--first] = '-';
+
+	fill (' ', the_width - ((int) sizeof (digits) - first));
+	write (digits + first, (int) sizeof (digits) - first);
+}
+
+
+//========================writeNumber=================================
+// Appends the double the way a stream with the default format does,
+// six significant digits, padded on the left with spaces to the int
+// width. The padding is added by fill, so the array only has to hold
+// the digits, which six significant digits and an exponent always 
+// fit in.
+//====================================================================
+void OutputBuffer::writeNumber (double the_value, int the_width)
+{
+	char text [32];
+	int length;
+
+	length = snprintf (text, sizeof (text), "%g", the_value);
+	if (length < 0) return;
+	if (length > (int) sizeof (text) - 1) length = (int) sizeof (text) - 1;
+
+	fill (' ', the_width - length);
+	write (text, length);
+}
+
+
+//========================flush=======================================
+// Writes the buffered characters to the stream.
+//
+// Preconditions: None.
+//
+// Postconditions: The buffer is empty.
+//====================================================================
+void OutputBuffer::flush ()
+{
+	if (my_used > 0) my_stream.write (&my_buffer [0], my_used);
+	my_used = 0;
+	my_stream.flush();
+}
+
+
+//========================reserve=====================================
+// Flushes the buffer if the int number of characters do not fit in
+// what is left of it.
+//====================================================================
+void OutputBuffer::reserve (int the_length)
+{
+	if (my_used + the_length > (int) my_buffer.size()) {
+		my_stream.write (&my_buffer [0], my_used);
+		my_used = 0;
+	}
+}
@@ -0,0 +1,111 @@
+//====================================================================
+// OutputBuffer.h
+//
+// This class represents a buffer that formats text in memory and
+// sends it to an output stream in large writes. It is used by
+// Graph.h to print the table in displayAll, which prints V^2 lines:
+// going through the stream's formatting for every field, and
+// flushing after every line, takes far longer than finding the
+// paths.
+//====================================================================
+// OutputBuffer class:
+//   Includes following features:
+// 	- allows writing characters, text and numbers, right aligned
+//	  in a field like setw does.
+//	- allows flushing the buffer to the stream.
+// Assumptions:
+// 	- nothing else writes to the stream until the buffer has
+//	  been flushed, so the output stays in order.
+//====================================================================
+
+#ifndef _OUTPUTBUFFER_H
+#define _OUTPUTBUFFER_H
+#include <iostream>
+#include <vector>
+using namespace std;
+
+class OutputBuffer {
+
+public:
+
+	//========================Constructor=========================
+	// Creates an OutputBuffer that writes to the given stream
+	// whenever the int number of characters have been buffered.
+	//
+	// Preconditions: The stream outlives the buffer.
+	//
+	// Postconditions: The buffer is empty.
+	//============================================================
+	OutputBuffer (ostream &, int = 1 << 16);
+
+
+	//========================Destructor==========================
+	// Flushes what is left in the buffer.
+	//============================================================
+	~OutputBuffer ();
+
+
+	//========================put=================================
+	// Appends the given character.
+	//============================================================
+	void put (char);
+
+
+	//========================fill================================
+	// Appends the given character the int number of times.
+	//============================================================
+	void fill (char, int);
+
+
+	//========================write===============================
+	// Appends the int number of characters starting at the given
+	// pointer.
+	//============================================================
+	void write (const char *, int);
+
+
+	//========================writeText===========================
+	// Appends the given '\0' terminated text, padded on the left
+	// with spaces to the int width, like setw does.
+	//============================================================
+	void writeText (const char *, int);
+
+
+	//========================writeNumber=========================
+	// Appends the number, padded on the left with spaces to the 
+	// int width, so writeNumber (x, 7) gives the same characters
+	// as cout << setw(7) << x.
+	//============================================================
+	void writeNumber (int, int = 0);
+	void writeNumber (long long, int = 0);
+	void writeNumber (double, int = 0);
+
+
+	//========================flush===============================
+	// Writes the buffered characters to the stream.
+	//
+	// Preconditions: None.
+	//
+	// Postconditions: The buffer is empty.
+	//============================================================
+	void flush ();
+
+private:
+
+	// The stream written to.
+	ostream &my_stream;
+
+	// The buffered characters.
+	vector<char> my_buffer;
+
+	// The number of characters buffered.
+	int my_used;
+
+
+	//========================reserve=============================
+	// Flushes the buffer if the int number of characters do not
+	// fit in what is left of it.
+	//============================================================
+	void reserve (int);
+};
+#endif /* _OUTPUTBUFFER_H */
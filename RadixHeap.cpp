@@ -0,0 +1,171 @@
+//====================================================================
+// RadixHeap.cpp
+//
+// This class represents a radix heap of vertices keyed by their
+// tentative distance. It is used by Graph.h as the priority queue of
+// Dijkstra's algorithm when the edge weights are too large for a
+// BucketQueue. It relies on keys never dropping below the last key
+// popped: a key goes in the bucket numbered by the highest bit where
+// it differs from that key, so there are 33 buckets for int keys, 
+// and an entry only ever moves to lower buckets, at most 32 times,
+// instead of sifting through a heap on every push and pop. It is a
+// template on the type of the keys, and RadixHeap is the one with 
+// int keys.
+//====================================================================
+// RadixHeap class:
+//   Includes following features:
+//	- allows pushing a vertex with a key.
+//	- allows popping a vertex with the smallest key.
+// Assumptions:
+// 	- keys are not negative, and are never less than the key of
+//	  the last vertex popped, which holds for Dijkstra's algorithm.
+//	- a vertex whose key drops is pushed again, and the caller
+//	  skips the stale copy when it is popped.
+//	- the keys are int or long long, the types RadixHeap.cpp
+//	  instantiates it for.
+//====================================================================
+
+#include "RadixHeap.h"
+
+
+//========================Default-Constructor=========================
+// Creates an empty RadixHeap.
+//
+// Preconditions: None.
+//
+// Postconditions: The heap is empty.
+//====================================================================
+template <class K>
+BasicRadixHeap<K>::BasicRadixHeap () : my_last (0), my_count (0)
+{
+}
+
+
+//========================reset=======================================
+// Empties the heap. The buckets keep their memory, so resetting
+// between sources allocates nothing.
+//
+// Preconditions: None.
+//
+// Postconditions: The heap is empty and its last key is 0.
+//====================================================================
+template <class K>
+void BasicRadixHeap<K>::reset ()
+{
+	int i;
+
+	if (my_count > 0) {
+		for (i = 0; i < BUCKETS; i++)
+			my_buckets [i].clear();
+	}
+	my_last  = 0;
+	my_count = 0;
+}
+
+
+//========================isEmpty=====================================
+// Returns true if the heap holds no vertices.
+//====================================================================
+template <class K>
+bool BasicRadixHeap<K>::isEmpty () const
+{
+	return my_count == 0;
+}
+
+
+//========================push========================================
+// Inserts the int (a vertex) with the given key.
+//
+// Preconditions: The key is at least the key of the last vertex
+//		  popped.
+//
+// Postconditions: The vertex is in the heap.
+//====================================================================
+template <class K>
+void BasicRadixHeap<K>::push (int the_vertex, K the_key)
+{
+	Entry entry;
+
+	entry.vertex = the_vertex;
+	entry.key    = (Key) the_key;
+	my_buckets [bucket (entry.key)].push_back (entry);
+	my_count++;
+}
+
+
+//========================pop=========================================
+// Removes and returns a vertex with the smallest key. If none has the
+// last key, the smallest key in the first bucket that is not empty
+// becomes the last key, and that bucket's entries are spread over
+// the lower buckets. They all share the bits above the one the
+// bucket stands for, so each lands in a lower bucket, and the new
+// last key's entries land in bucket 0.
+//
+// Preconditions: The heap is not empty.
+//
+// Postconditions: getKey returns the key it had.
+//====================================================================
+template <class K>
+int BasicRadixHeap<K>::pop ()
+{
+	int i, index;
+	Entry entry;
+
+	if (my_buckets [0].empty()) {
+		index = 1;
+		while (my_buckets [index].empty()) index++;
+
+		vector<Entry> &moving = my_buckets [index];
+		my_last = moving [0].key;
+		for (i = 1; i < (int) moving.size(); i++) {
+			if (moving [i].key < my_last) my_last = moving [i].key;
+		}
+		for (i = 0; i < (int) moving.size(); i++)
+			my_buckets [bucket (moving [i].key)].push_back (moving [i]);
+		moving.clear();
+	}
+
+	entry = my_buckets [0].back();
+	my_buckets [0].pop_back();
+	my_count--;
+	return entry.vertex;
+}
+
+
+//========================getKey======================================
+// Returns the key of the last vertex popped.
+//====================================================================
+template <class K>
+K BasicRadixHeap<K>::getKey () const
+{
+	return (K) my_last;
+}
+
+
+//========================bucket======================================
+// Returns the bucket of the given key: 0 if it equals my_last, and
+// otherwise one more than the position of the highest bit where the
+// two differ.
+//====================================================================
+template <class K>
+int BasicRadixHeap<K>::bucket (Key the_key) const
+{
+	Key difference = the_key ^ my_last;
+	int bits = 0;
+
+#ifdef __GNUC__
+	if (difference != 0) 
+		bits = 64 - __builtin_clzll ((unsigned long long) difference);
+	return bits;
+#endif
+	while (difference != 0) {
+		difference >>= 1;
+		bits++;
+	}
+	return bits;
+}
+
+
+// The key types of the graphs Graph.cpp instantiates.
+template class BasicRadixHeap<int>;
+template class BasicRadixHeap<long long>;
@@ -0,0 +1,128 @@
+//====================================================================
+// RadixHeap.h
+//
+// This class represents a radix heap of vertices keyed by their
+// tentative distance. It is used by Graph.h as the priority queue of
+// Dijkstra's algorithm when the edge weights are too large for a
+// BucketQueue. It relies on keys never dropping below the last key
+// popped: a key goes in the bucket numbered by the highest bit where
+// it differs from that key, so there are 33 buckets for int keys, 
+// and an entry only ever moves to lower buckets, at most 32 times,
+// instead of sifting through a heap on every push and pop. It is a
+// template on the type of the keys, and RadixHeap is the one with 
+// int keys.
+//====================================================================
+// RadixHeap class:
+//   Includes following features:
+//	- allows pushing a vertex with a key.
+//	- allows popping a vertex with the smallest key.
+// Assumptions:
+// 	- keys are not negative, and are never less than the key of
+//	  the last vertex popped, which holds for Dijkstra's algorithm.
+//	- a vertex whose key drops is pushed again, and the caller
+//	  skips the stale copy when it is popped.
+//	- the keys are int or long long, the types RadixHeap.cpp
+//	  instantiates it for.
+//====================================================================
+
+#ifndef _RADIXHEAP_H
+#define _RADIXHEAP_H
+#include <vector>
+#include <type_traits>
+using namespace std;
+
+template <class K>
+class BasicRadixHeap {
+
+public:
+
+	//========================Default-Constructor=================
+	// Creates an empty RadixHeap.
+	//
+	// Preconditions: None.
+	//
+	// Postconditions: The heap is empty.
+	//============================================================
+	BasicRadixHeap ();
+
+
+	//========================reset===============================
+	// Empties the heap.
+	//
+	// Preconditions: None.
+	//
+	// Postconditions: The heap is empty and its last key is 0.
+	//============================================================
+	void reset ();
+
+
+	//========================isEmpty=============================
+	// Returns true if the heap holds no vertices.
+	//============================================================
+	bool isEmpty () const;
+
+
+	//========================push================================
+	// Inserts the int (a vertex) with the given key.
+	//
+	// Preconditions: The key is at least the key of the last
+	//		  vertex popped.
+	//
+	// Postconditions: The vertex is in the heap.
+	//============================================================
+	void push (int, K);
+
+
+	//========================pop=================================
+	// Removes and returns a vertex with the smallest key.
+	//
+	// Preconditions: The heap is not empty.
+	//
+	// Postconditions: getKey returns the key it had.
+	//============================================================
+	int pop ();
+
+
+	//========================getKey==============================
+	// Returns the key of the last vertex popped.
+	//============================================================
+	K getKey () const;
+
+private:
+
+	// The keys are compared as unsigned, so the bits line up 
+	// with their order.
+	typedef typename make_unsigned<K>::type Key;
+
+	// A vertex and its key.
+	struct Entry {
+		int vertex;
+		Key key;
+	};
+
+	// One bucket for keys equal to the last key, and one for each
+	// bit they can differ in first.
+	static const int BUCKETS = (int) sizeof (K) * 8 + 1;
+
+
+	//========================bucket==============================
+	// Returns the bucket of the given key.
+	//============================================================
+	int bucket (Key) const;
+
+
+	// The buckets. Bucket 0 holds keys equal to my_last, and
+	// bucket b the keys whose highest bit different from my_last
+	// is bit b - 1.
+	vector<Entry> my_buckets [BUCKETS];
+
+	// The key of the last vertex popped.
+	Key my_last;
+
+	// The number of vertices in the heap.
+	int my_count;
+};
+
+// The radix heap used with int distances.
+typedef BasicRadixHeap<int> RadixHeap;
+#endif /* _RADIXHEAP_H */
@@ -0,0 +1,131 @@
+//====================================================================
+// Scheduler.cpp
+//
+// This class represents a work-stealing scheduler that hands out a
+// range of int tasks (source vertices) to a fixed number of worker
+// threads. It is used in Graph.h to run Dijkstra's algorithm from
+// every source in parallel.
+//====================================================================
+// Scheduler class:
+//   Includes following features:
+// 	- allows splitting a range of tasks evenly between workers.
+//	- allows a worker to take its next task.
+//	- allows an idle worker to steal half of the remaining tasks
+//	  of the busiest worker.
+// Assumptions:
+// 	- each worker number is used by only one thread.
+//====================================================================
+
+#include "Scheduler.h"
+
+
+//========================Constructor=================================
+// Creates a Scheduler for the given number of workers, and splits the
+// tasks from the second int to the third int (inclusive) into one
+// contiguous block per worker.
+//
+// Preconditions: The number of workers is at least 1.
+//
+// Postconditions: Every task is owned by exactly one worker.
+//====================================================================
+Scheduler::Scheduler (int the_workers, int the_first, int the_last)
+{
+	int worker;
+	long total = (long) the_last - the_first + 1;
+
+	if (total < 0) total = 0;
+
+	for (worker = 0; worker < the_workers; worker++) {
+		Block *block = new Block;
+		block->first = the_first + (int) (total * worker / the_workers);
+		block->last  = the_first + (int) (total * (worker + 1) / the_workers);
+		my_blocks.push_back (block);
+	}
+}
+
+
+//========================Destructor==================================
+// Deallocates all resources obtained by this Scheduler.
+//====================================================================
+Scheduler::~Scheduler ()
+{
+	int worker;
+	for (worker = 0; worker < (int) my_blocks.size(); worker++)
+		delete my_blocks [worker];
+}
+
+
+//========================next========================================
+// Sets the second int to the next task for the worker given by the
+// first int. If the worker has no tasks left, it steals the upper
+// half of the largest remaining block.
+//
+// Preconditions: The worker number is valid.
+//
+// Postconditions: Returns true and sets the task if one was found,
+//		   returns false once all tasks are taken.
+//====================================================================
+bool Scheduler::next (int the_worker, int &the_task)
+{
+	Block *own = my_blocks [the_worker];
+
+	for (;;) {
+		{
+			lock_guard<mutex> guard (own->lock);
+			if (own->first < own->last) {
+				the_task = own->first++;
+				return true;
+			}
+		}
+		if (!steal (the_worker)) return false;
+	}
+}
+
+
+//========================steal=======================================
+// Moves the upper half of the largest other block into the given
+// worker's block, rounded down, so the victim always keeps the task
+// it would take next. A block with one task left is not worth 
+// stealing from: its owner takes that task as soon as it is free.
+// The victim is picked without holding any lock, so its block is 
+// checked again once it is locked.
+//
+// Postconditions: Returns false if no other worker had two tasks 
+//		   left.
+//====================================================================
+bool Scheduler::steal (int the_worker)
+{
+	int worker, victim, most, left, middle, last;
+
+	for (;;) {
+		// Find the worker with the most tasks left.
+		victim = -1;
+		most   = 1;
+		for (worker = 0; worker < (int) my_blocks.size(); worker++) {
+			if (worker == the_worker) continue;
+			lock_guard<mutex> guard (my_blocks [worker]->lock);
+			left = my_blocks [worker]->last - my_blocks [worker]->first;
+			if (left > most) {
+				most   = left;
+				victim = worker;
+			}
+		}
+		if (victim == -1) return false;
+
+		// Take the upper half, the victim keeps the task it
+		// would take next, and the odd one out.
+		{
+			lock_guard<mutex> guard (my_blocks [victim]->lock);
+			left = my_blocks [victim]->last - my_blocks [victim]->first;
+			if (left <= 1) continue;
+			last   = my_blocks [victim]->last;
+			middle = last - left / 2;
+			my_blocks [victim]->last = middle;
+		}
+
+		lock_guard<mutex> guard (my_blocks [the_worker]->lock);
+		my_blocks [the_worker]->first = middle;
+		my_blocks [the_worker]->last  = last;
+		return true;
+	}
+}
@@ -0,0 +1,92 @@
+//====================================================================
+// Scheduler.h
+//
+// This class represents a work-stealing scheduler that hands out a
+// range of int tasks (source vertices) to a fixed number of worker
+// threads. It is used in Graph.h to run Dijkstra's algorithm from
+// every source in parallel.
+//====================================================================
+// Scheduler class:
+//   Includes following features:
+// 	- allows splitting a range of tasks evenly between workers.
+//	- allows a worker to take its next task.
+//	- allows an idle worker to steal half of the remaining tasks
+//	  of the busiest worker.
+// Assumptions:
+// 	- each worker number is used by only one thread.
+//====================================================================
+
+#ifndef _SCHEDULER_H
+#define _SCHEDULER_H
+#include <mutex>
+#include <vector>
+using namespace std;
+
+class Scheduler {
+
+public:
+
+	//========================Constructor=========================
+	// Creates a Scheduler for the given number of workers, and
+	// splits the tasks from the second int to the third int
+	// (inclusive) into one contiguous block per worker.
+	//
+	// Preconditions: The number of workers is at least 1.
+	//
+	// Postconditions: Every task is owned by exactly one worker.
+	//============================================================
+	Scheduler (int, int, int);
+
+
+	//========================Destructor==========================
+	// Deallocates all resources obtained by this Scheduler.
+	//============================================================
+	~Scheduler ();
+
+
+	//========================next================================
+	// Sets the second int to the next task for the worker given
+	// by the first int. If the worker has no tasks left, it
+	// steals the upper half of the largest remaining block.
+	//
+	// Preconditions: The worker number is valid.
+	//
+	// Postconditions: Returns true and sets the task if one was
+	//		   found, returns false once all tasks are taken.
+	//============================================================
+	bool next (int, int &);
+
+private:
+
+	// The tasks still owned by one worker, from first up to
+	// but not including last.
+	struct Block {
+		// Guards first and last.
+		mutex lock;
+		// The next task the owner will take.
+		int first;
+		// One past the last task in the block.
+		int last;
+	};
+
+
+	//========================steal===============================
+	// Moves the upper half of the largest other block into the
+	// given worker's block, leaving the victim the task it would
+	// take next.
+	//
+	// Postconditions: Returns false if no other worker had two
+	//		   tasks left.
+	//============================================================
+	bool steal (int);
+
+
+	// Not copyable, each Block owns a mutex.
+	Scheduler (const Scheduler &);
+	Scheduler &operator= (const Scheduler &);
+
+
+	// One block per worker.
+	vector<Block *> my_blocks;
+};
+#endif /* _SCHEDULER_H */
@@ -0,0 +1,139 @@
+//====================================================================
+// StringPool.cpp
+//
+// This class represents a pool of strings stored end to end in one
+// array, each distinct string once. It is used by Graph.h for the
+// descriptions of the vertices: a vertex keeps only the int that
+// names its string, so a short or repeated description costs 4 bytes
+// instead of a buffer of its own, and no description is cut short.
+// Strings are found again through a hash table of the ints, so
+// interning a string that is already pooled stores nothing.
+//====================================================================
+// StringPool class:
+//   Includes following features:
+//	- allows interning a string of any length, getting back the
+//	  int of the equal string already pooled if there is one.
+//	- allows reading a string and its length by its int.
+// Assumptions:
+// 	- the strings are not '\0' terminated, and may hold any char.
+//	- the pooled strings total less than 2^31 chars.
+//	- a pointer from getData stays valid until the next intern.
+//====================================================================
+
+#include "StringPool.h"
+#include <string.h> // memcmp
+
+
+//========================Default-Constructor=========================
+// Creates an empty StringPool.
+//
+// Preconditions: None.
+//
+// Postconditions: The pool holds no strings.
+//====================================================================
+StringPool::StringPool () : my_offsets (1, 0), my_slots (16, -1)
+{
+}
+
+
+//========================intern======================================
+// Returns the int of the string of the given int length starting at
+// the given pointer, adding it to the pool if no equal string is
+// there yet. The table is probed from the slot the hash picks until
+// the string or an empty slot turns up.
+//
+// Preconditions: The pointer has at least that many chars.
+//
+// Postconditions: The pool holds the string.
+//====================================================================
+int StringPool::intern (const char *the_data, int the_length)
+{
+	int mask = (int) my_slots.size() - 1;
+	int slot = (int) (hash (the_data, the_length) & mask);
+	int id;
+
+	while ((id = my_slots [slot]) != -1) {
+		if (getLength (id) == the_length &&
+		    memcmp (getData (id), the_data, the_length) == 0)
+			return id;
+		slot = (slot + 1) & mask;
+	}
+
+	id = getCount();
+	my_text.insert (my_text.end(), the_data, the_data + the_length);
+	my_offsets.push_back ((int) my_text.size());
+	my_slots [slot] = id;
+	if (2 * getCount() > (int) my_slots.size()) grow();
+	return id;
+}
+
+
+//========================getData=====================================
+// Returns a pointer to the string with the given int. It is not '\0'
+// terminated.
+//====================================================================
+const char *StringPool::getData (int the_id) const
+{
+	return my_text.data() + my_offsets [the_id];
+}
+
+
+//========================getLength===================================
+// Returns the length of the string with the given int.
+//====================================================================
+int StringPool::getLength (int the_id) const
+{
+	return my_offsets [the_id + 1] - my_offsets [the_id];
+}
+
+
+//========================getCount====================================
+// Returns the number of distinct strings in the pool.
+//====================================================================
+int StringPool::getCount () const
+{
+	return (int) my_offsets.size() - 1;
+}
+
+
+//========================getSize=====================================
+// Returns the total length of the distinct strings.
+//====================================================================
+int StringPool::getSize () const
+{
+	return (int) my_text.size();
+}
+
+
+//========================hash========================================
+// Returns the FNV-1a hash of the int number of chars starting at the
+// given pointer.
+//====================================================================
+unsigned int StringPool::hash (const char *the_data, int the_length)
+{
+	unsigned int value = 2166136261u;
+	int i;
+
+	for (i = 0; i < the_length; i++) {
+		value ^= (unsigned char) the_data [i];
+		value *= 16777619u;
+	}
+	return value;
+}
+
+
+//========================grow========================================
+// Doubles the hash table and puts every string back in it.
+//====================================================================
+void StringPool::grow ()
+{
+	int id, slot, mask;
+
+	my_slots.assign (my_slots.size() * 2, -1);
+	mask = (int) my_slots.size() - 1;
+	for (id = 0; id < getCount(); id++) {
+		slot = (int) (hash (getData (id), getLength (id)) & mask);
+		while (my_slots [slot] != -1) slot = (slot + 1) & mask;
+		my_slots [slot] = id;
+	}
+}
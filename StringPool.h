@@ -0,0 +1,104 @@
+//====================================================================
+// StringPool.h
+//
+// This class represents a pool of strings stored end to end in one
+// array, each distinct string once. It is used by Graph.h for the
+// descriptions of the vertices: a vertex keeps only the int that
+// names its string, so a short or repeated description costs 4 bytes
+// instead of a buffer of its own, and no description is cut short.
+// Strings are found again through a hash table of the ints, so
+// interning a string that is already pooled stores nothing.
+//====================================================================
+// StringPool class:
+//   Includes following features:
+//	- allows interning a string of any length, getting back the
+//	  int of the equal string already pooled if there is one.
+//	- allows reading a string and its length by its int.
+// Assumptions:
+// 	- the strings are not '\0' terminated, and may hold any char.
+//	- the pooled strings total less than 2^31 chars.
+//	- a pointer from getData stays valid until the next intern.
+//====================================================================
+
+#ifndef _STRINGPOOL_H
+#define _STRINGPOOL_H
+#include <vector>
+using namespace std;
+
+class StringPool {
+
+public:
+
+	//========================Default-Constructor=================
+	// Creates an empty StringPool.
+	//
+	// Preconditions: None.
+	//
+	// Postconditions: The pool holds no strings.
+	//============================================================
+	StringPool ();
+
+
+	//========================intern==============================
+	// Returns the int of the string of the given int length
+	// starting at the given pointer, adding it to the pool if no
+	// equal string is there yet. The ints count up from 0 in the
+	// order the strings were added.
+	//
+	// Preconditions: The pointer has at least that many chars.
+	//
+	// Postconditions: The pool holds the string.
+	//============================================================
+	int intern (const char *, int);
+
+
+	//========================getData=============================
+	// Returns a pointer to the string with the given int. It is
+	// not '\0' terminated.
+	//============================================================
+	const char *getData (int) const;
+
+
+	//========================getLength===========================
+	// Returns the length of the string with the given int.
+	//============================================================
+	int getLength (int) const;
+
+
+	//========================getCount============================
+	// Returns the number of distinct strings in the pool.
+	//============================================================
+	int getCount () const;
+
+
+	//========================getSize=============================
+	// Returns the total length of the distinct strings.
+	//============================================================
+	int getSize () const;
+
+private:
+
+	// The strings, end to end. String i is at my_offsets[i] up
+	// to my_offsets[i + 1].
+	vector<char> my_text;
+	vector<int> my_offsets;
+
+	// The hash table: the int of a string, or -1 for an empty
+	// slot. Its size is a power of 2, at least twice the number
+	// of strings, and collisions try the next slot.
+	vector<int> my_slots;
+
+
+	//========================hash================================
+	// Returns the FNV-1a hash of the int number of chars starting
+	// at the given pointer.
+	//============================================================
+	static unsigned int hash (const char *, int);
+
+
+	//========================grow================================
+	// Doubles the hash table and puts every string back in it.
+	//============================================================
+	void grow ();
+};
+#endif /* _STRINGPOOL_H */
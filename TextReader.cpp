@@ -0,0 +1,213 @@
+//====================================================================
+// TextReader.cpp
+//
+// This class represents a fast line reader over an input stream. It
+// reads the stream in large blocks and hands out whole lines as
+// pointers into its buffer, and it can scan ints out of a line
+// without going through iostream formatting. It is used by Graph.h
+// to parse the text graph format.
+//====================================================================
+// TextReader class:
+//   Includes following features:
+// 	- allows reading the next line of the stream.
+//	- allows knowing the line number of the last line read.
+//	- allows scanning an int from a line.
+//	- allows giving the bytes read ahead back to the stream.
+// Assumptions:
+// 	- nothing else reads from the stream while the TextReader is
+//	  in use.
+//====================================================================
+
+#include "TextReader.h"
+#include <string.h> // memchr, memmove
+#include <limits.h>
+
+
+//========================Constructor=================================
+// Creates a TextReader that reads from the given stream, starting at
+// its current position.
+//
+// Preconditions: None.
+//
+// Postconditions: No line has been read yet.
+//====================================================================
+TextReader::TextReader (istream &the_input)
+	: my_input (the_input), my_start (the_input.tellg()),
+	  my_buffer (BLOCK_SIZE), my_next (0), my_end (0),
+	  my_consumed (0), my_line (0), my_eof (false), my_hit_end (false)
+{
+}
+
+
+//========================nextLine====================================
+// Sets the pointer to the next line and the int to its length,
+// without the '\n' or a trailing '\r'. The line stays valid until the
+// next call.
+//
+// Preconditions: None.
+//
+// Postconditions: Returns false if there are no lines left.
+//====================================================================
+bool TextReader::nextLine (const char *&the_data, int &the_length)
+{
+	char *newline;
+	int scanned = 0;
+
+	// Find the end of the line, reading more until it is there.
+	for (;;) {
+		newline = (char *) memchr (&my_buffer [0] + my_next + scanned, '\n',
+					   my_end - my_next - scanned);
+		if (newline != NULL) break;
+		scanned = my_end - my_next;
+		if (!refill()) break;
+	}
+
+	// Nothing left at all.
+	if (newline == NULL && my_next == my_end) {
+		my_hit_end = true;
+		return false;
+	}
+
+	the_data = &my_buffer [0] + my_next;
+	if (newline != NULL) {
+		the_length   = (int) (newline - the_data);
+		my_next     += the_length + 1;
+		my_consumed += the_length + 1;
+	} else {
+		// The last line has no '\n'.
+		the_length   = my_end - my_next;
+		my_next      = my_end;
+		my_consumed += the_length;
+		my_hit_end   = true;
+	}
+	if (the_length > 0 && the_data [the_length - 1] == '\r')
+		the_length--;
+	my_line++;
+	return true;
+}
+
+
+//========================getLine=====================================
+// Returns the line number of the last line read, starting from 1.
+//====================================================================
+int TextReader::getLine () const
+{
+	return my_line;
+}
+
+
+//========================hitEnd======================================
+// Returns true if the end of the stream was reached, either by asking
+// for a line past it or by reading a last line with no '\n'.
+//====================================================================
+bool TextReader::hitEnd () const
+{
+	return my_hit_end;
+}
+
+
+//========================finish======================================
+// Gives the bytes that were read ahead but not handed out back to the
+// stream, by seeking it to just after the last line read. Sets eof on
+// the stream if hitEnd is true.
+//
+// Preconditions: The stream is seekable, otherwise the bytes read
+//		  ahead are lost.
+//
+// Postconditions: The stream is positioned after the last line read.
+//====================================================================
+void TextReader::finish ()
+{
+	my_input.clear();
+	if (my_start != streampos (-1))
+		my_input.seekg (my_start + (streamoff) my_consumed);
+	if (my_hit_end)
+		my_input.setstate (ios::eofbit);
+}
+
+
+//========================parseInt====================================
+// Skips blanks from the first pointer, then scans an optional '-' and
+// decimal digits into the int. The first pointer is moved past the
+// number. The second pointer is the end of the line.
+//
+// Preconditions: None.
+//
+// Postconditions: Returns false, without moving the pointer, if there
+//		   is no number or it does not fit in an int.
+//====================================================================
+bool TextReader::parseInt (const char *&the_cur, const char *the_end,
+			   int &the_value)
+{
+	const char *cur = the_cur;
+	bool negative = false;
+	long long value = 0;
+	int digits = 0;
+
+	skipBlanks (cur, the_end);
+	if (cur < the_end && *cur == '-') {
+		negative = true;
+		cur++;
+	}
+	while (cur < the_end && *cur >= '0' && *cur <= '9') {
+		value = value * 10 + (*cur - '0');
+		if (value > (long long) INT_MAX + 1) return false;
+		digits++;
+		cur++;
+	}
+	if (digits == 0) return false;
+	if (negative) value = -value;
+	if (value > INT_MAX || value < INT_MIN) return false;
+
+	// The number has to end at a blank or the end of the line.
+	if (cur < the_end && *cur != ' ' && *cur != '\t' && *cur != '\r')
+		return false;
+
+	the_value = (int) value;
+	the_cur   = cur;
+	return true;
+}
+
+
+//========================skipBlanks==================================
+// Moves the first pointer past spaces, tabs and '\r' up to the second
+// pointer. Returns true if it reaches the second.
+//====================================================================
+bool TextReader::skipBlanks (const char *&the_cur, const char *the_end)
+{
+	while (the_cur < the_end &&
+	       (*the_cur == ' ' || *the_cur == '\t' || *the_cur == '\r'))
+		the_cur++;
+	return the_cur == the_end;
+}
+
+
+//========================refill======================================
+// Moves the unread bytes to the front of the buffer and reads another
+// block after them, growing the buffer if it is full.
+//
+// Postconditions: Returns false if nothing more could be read.
+//====================================================================
+bool TextReader::refill ()
+{
+	streamsize count;
+
+	if (my_eof) return false;
+
+	// Keep the unread bytes, they are part of the current line.
+	if (my_next > 0) {
+		memmove (&my_buffer [0], &my_buffer [0] + my_next, my_end - my_next);
+		my_end -= my_next;
+		my_next = 0;
+	}
+	if ((int) my_buffer.size() - my_end < BLOCK_SIZE)
+		my_buffer.resize (my_end + BLOCK_SIZE);
+
+	count = my_input.rdbuf()->sgetn (&my_buffer [0] + my_end, BLOCK_SIZE);
+	if (count <= 0) {
+		my_eof = true;
+		return false;
+	}
+	my_end += (int) count;
+	return true;
+}
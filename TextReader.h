@@ -0,0 +1,142 @@
+//====================================================================
+// TextReader.h
+//
+// This class represents a fast line reader over an input stream. It
+// reads the stream in large blocks and hands out whole lines as
+// pointers into its buffer, and it can scan ints out of a line
+// without going through iostream formatting. It is used by Graph.h
+// to parse the text graph format.
+//====================================================================
+// TextReader class:
+//   Includes following features:
+// 	- allows reading the next line of the stream.
+//	- allows knowing the line number of the last line read.
+//	- allows scanning an int from a line.
+//	- allows giving the bytes read ahead back to the stream.
+// Assumptions:
+// 	- nothing else reads from the stream while the TextReader is
+//	  in use.
+//====================================================================
+
+#ifndef _TEXTREADER_H
+#define _TEXTREADER_H
+#include <iostream>
+#include <vector>
+using namespace std;
+
+class TextReader {
+
+public:
+
+	//========================Constructor=========================
+	// Creates a TextReader that reads from the given stream,
+	// starting at its current position.
+	//
+	// Preconditions: None.
+	//
+	// Postconditions: No line has been read yet.
+	//============================================================
+	TextReader (istream &);
+
+
+	//========================nextLine============================
+	// Sets the pointer to the next line and the int to its
+	// length, without the '\n' or a trailing '\r'. The line stays
+	// valid until the next call.
+	//
+	// Preconditions: None.
+	//
+	// Postconditions: Returns false if there are no lines left.
+	//============================================================
+	bool nextLine (const char *&, int &);
+
+
+	//========================getLine=============================
+	// Returns the line number of the last line read, starting
+	// from 1.
+	//============================================================
+	int getLine () const;
+
+
+	//========================hitEnd==============================
+	// Returns true if the end of the stream was reached, either
+	// by asking for a line past it or by reading a last line
+	// with no '\n'.
+	//============================================================
+	bool hitEnd () const;
+
+
+	//========================finish==============================
+	// Gives the bytes that were read ahead but not handed out
+	// back to the stream, by seeking it to just after the last
+	// line read. Sets eof on the stream if hitEnd is true.
+	//
+	// Preconditions: The stream is seekable, otherwise the bytes
+	//		  read ahead are lost.
+	//
+	// Postconditions: The stream is positioned after the last
+	//		   line read.
+	//============================================================
+	void finish ();
+
+
+	//========================parseInt============================
+	// Skips blanks from the first pointer, then scans an optional
+	// '-' and decimal digits into the int. The first pointer is
+	// moved past the number. The second pointer is the end of
+	// the line.
+	//
+	// Preconditions: None.
+	//
+	// Postconditions: Returns false, without moving the pointer,
+	//		   if there is no number or it does not fit in
+	//		   an int.
+	//============================================================
+	static bool parseInt (const char *&, const char *, int &);
+
+
+	//========================skipBlanks==========================
+	// Moves the first pointer past spaces, tabs and '\r' up to
+	// the second pointer. Returns true if it reaches the second.
+	//============================================================
+	static bool skipBlanks (const char *&, const char *);
+
+private:
+
+	//========================refill==============================
+	// Moves the unread bytes to the front of the buffer and reads
+	// another block after them, growing the buffer if it is full.
+	//
+	// Postconditions: Returns false if nothing more could be read.
+	//============================================================
+	bool refill ();
+
+
+	// The size of each block read from the stream.
+	static const int BLOCK_SIZE = 1 << 20;
+
+	// The stream being read.
+	istream &my_input;
+
+	// Where the stream was when the TextReader was created.
+	streampos my_start;
+
+	// The bytes read from the stream. The unread ones are at
+	// my_next up to my_end.
+	vector<char> my_buffer;
+	int my_next;
+	int my_end;
+
+	// The number of bytes handed out as lines, counting '\n'.
+	long long my_consumed;
+
+	// The line number of the last line read.
+	int my_line;
+
+	// True once the stream has no more bytes.
+	bool my_eof;
+
+	// True once the end of the stream was reached by a line.
+	bool my_hit_end;
+};
+#endif /* _TEXTREADER_H */
@@ -0,0 +1,166 @@
+//---------------------------------------------------------------------------
+// BENCH_ARENA.CPP
+// Counts and times the allocations of a graph's edge nodes from an Arena
+// against allocating each one with new, and times building, copying and
+// tearing down a Graph, whose EdgeNodes come from its Arena.
+//---------------------------------------------------------------------------
+// Usage: bench_arena [vertices [edges]]
+//
+// The nodes are allocated the way Graph does: two per edge, one in the
+// edge list and one in the reverse list, each the size of an EdgeNode.
+// The Arena is timed both grown slab by slab and reserved up front, as
+// buildGraph and the copy constructor reserve it. The graph is written
+// to bench_arena.txt in the current directory, read in lazy mode so no
+// table is computed, and removed at the end.
+//
+// Assumptions:
+//   -- the counts are positive.
+//---------------------------------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <stdlib.h>
+#include <stdio.h>
+#include "Graph.h"
+#include "Arena.h"
+#include "GraphGenerator.h"
+using namespace std;
+
+// The file the generated graph is written to.
+static const char *INPUT_FILE = "bench_arena.txt";
+
+// The same size as a Graph EdgeNode.
+struct Node {
+   int adjVertex;
+   int weight;
+   Node *nextEdge;
+};
+
+
+//-------------------------- seconds_since ----------------------------------
+// Returns the seconds from the given time to now.
+static double seconds_since(chrono::steady_clock::time_point start) {
+   return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+
+//-------------------------- print_time -------------------------------------
+// Prints the label and the seconds as milliseconds.
+static void print_time(const char *label, double seconds) {
+   cout << left << setw(30) << label << right << fixed << setprecision(3)
+        << setw(10) << seconds * 1000 << " ms" << endl;
+}
+
+
+//-------------------------- time_new ---------------------------------------
+// Allocates the given number of nodes with new, links each to the last,
+// and deletes them. Prints the time of each half.
+static void time_new(int nodes) {
+   vector<Node *> all(nodes);
+   Node *last = NULL;
+
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   for (int i = 0; i < nodes; i++) {
+      all [i] = new Node;
+      all [i]->adjVertex = i;
+      all [i]->nextEdge  = last;
+      last = all [i];
+   }
+   double allocated = seconds_since(start);
+
+   start = chrono::steady_clock::now();
+   for (int i = 0; i < nodes; i++) delete all [i];
+   double freed = seconds_since(start);
+
+   cout << "new/delete: " << nodes << " allocations" << endl;
+   print_time("  allocate", allocated);
+   print_time("  free", freed);
+}
+
+
+//-------------------------- time_arena -------------------------------------
+// Allocates the given number of nodes from an Arena, reserved up front
+// if the bool is true, links each to the last, and releases them. Prints
+// the slab count, the bytes used and the time of each half.
+static void time_arena(int nodes, bool reserved) {
+   Arena arena;
+   Node *node, *last = NULL;
+
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   if (reserved) arena.reserve((size_t) nodes * sizeof (Node));
+   for (int i = 0; i < nodes; i++) {
+      node = (Node *) arena.allocate(sizeof (Node));
+      node->adjVertex = i;
+      node->nextEdge  = last;
+      last = node;
+   }
+   double allocated = seconds_since(start);
+   int slabs = arena.getSlabCount();
+   size_t used = arena.getBytesUsed();
+
+   start = chrono::steady_clock::now();
+   arena.release();
+   double freed = seconds_since(start);
+
+   cout << "Arena, " << (reserved ? "reserved" : "grown") << ": " << slabs
+        << " allocations (slabs), " << used << " bytes used" << endl;
+   print_time("  allocate", allocated);
+   print_time("  free", freed);
+}
+
+
+//-------------------------- main -------------------------------------------
+// Times the node allocations, then the graph's build, copy and teardown.
+// Preconditions:   The current directory is writable.
+// Postconditions:  The counts and times are printed, or an error is
+//                  printed and 1 is returned.
+int main(int argc, char *argv[]) {
+   int vertices = (argc > 1) ? atoi(argv[1]) : 200000;
+   int edges    = (argc > 2) ? atoi(argv[2]) : 2000000;
+   if (argc > 3 || vertices < 1 || edges < 1) {
+      cerr << "Usage: " << argv[0] << " [vertices [edges]]" << endl;
+      return 1;
+   }
+
+   cout << vertices << " vertices, " << edges << " edges" << endl;
+   time_new(edges * 2);
+   time_arena(edges * 2, false);
+   time_arena(edges * 2, true);
+
+   GraphGenerator generator(1);
+   generator.makeRandom(vertices, edges, 1000);
+   if (!generator.write(INPUT_FILE)) {
+      cerr << "File could not be written." << endl;
+      return 1;
+   }
+
+   Graph *G = new Graph;
+   G->setLazy(true);
+   ifstream infile(INPUT_FILE);
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   G->buildGraph(infile);
+   double built = seconds_since(start);
+   infile.close();
+   remove(INPUT_FILE);
+
+   start = chrono::steady_clock::now();
+   Graph *copy = new Graph(*G);
+   double copied = seconds_since(start);
+
+   start = chrono::steady_clock::now();
+   delete copy;
+   double copy_torn = seconds_since(start);
+
+   start = chrono::steady_clock::now();
+   delete G;
+   double torn = seconds_since(start);
+
+   cout << "Graph:" << endl;
+   print_time("  lazy buildGraph", built);
+   print_time("  copy", copied);
+   print_time("  tear down the copy", copy_torn);
+   print_time("  tear down the graph", torn);
+   return 0;
+}
@@ -0,0 +1,174 @@
+//---------------------------------------------------------------------------
+// BENCH_PARSE.CPP
+// Times parsing the text graph format with a TextReader, the way
+// Graph::buildGraph does, against the ifstream >> parse it replaced, on a
+// large random graph.
+//---------------------------------------------------------------------------
+// Usage: bench_parse [vertices [edges [runs]]]
+//
+// The graph is written to bench_parse.txt in the current directory and
+// removed at the end. Each parse reads the vertex count, the
+// descriptions and the edges up to the line of zeros, and sums the ints
+// so both parses are checked to read the same numbers. A whole lazy
+// buildGraph, which also links the edges in, is timed as well. The best
+// of the runs is printed for each, with its throughput in MB/s of the
+// file (2^20 bytes).
+//
+// Assumptions:
+//   -- the counts are positive.
+//---------------------------------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include "Graph.h"
+#include "GraphGenerator.h"
+#include "TextReader.h"
+using namespace std;
+
+// The file the generated graph is written to.
+static const char *INPUT_FILE = "bench_parse.txt";
+
+
+//-------------------------- seconds_since ----------------------------------
+// Returns the seconds from the given time to now.
+static double seconds_since(chrono::steady_clock::time_point start) {
+   return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+
+//-------------------------- file_megabytes ---------------------------------
+// Returns the size of the named file in MB (2^20 bytes).
+static double file_megabytes(const char *path) {
+   ifstream infile(path, ios::in | ios::binary);
+   infile.seekg(0, ios::end);
+   return (double) infile.tellg() / (1 << 20);
+}
+
+
+//-------------------------- print_rate -------------------------------------
+// Prints the label, the seconds as milliseconds, and the megabytes read
+// per second.
+static void print_rate(const char *label, double seconds, double megabytes) {
+   cout << left << setw(19) << label << right << fixed << setprecision(3)
+        << setw(9) << seconds * 1000 << " ms" << setprecision(1)
+        << setw(9) << megabytes / seconds << " MB/s";
+}
+
+
+//-------------------------- stream_parse -----------------------------------
+// Parses the file the way buildGraph did before the TextReader: >> for
+// the ints and getline for the descriptions. Returns the sum of the ints.
+static long long stream_parse(const char *path) {
+   ifstream infile(path);
+   string description;
+   long long sum = 0;
+   int size, from, to, weight;
+
+   infile >> size;
+   infile.ignore();
+   for (int vertex = 1; vertex <= size; vertex++)
+      getline(infile, description);
+   for (;;) {
+      infile >> from >> to >> weight;
+      if (from == 0 || infile.eof()) break;
+      sum += from + to + weight;
+   }
+   return sum + size;
+}
+
+
+//-------------------------- reader_parse -----------------------------------
+// Parses the file the way buildGraph does now: whole lines from a
+// TextReader, and the ints scanned out of them by hand. Returns the sum
+// of the ints.
+static long long reader_parse(const char *path) {
+   ifstream infile(path);
+   TextReader reader(infile);
+   const char *line, *end;
+   long long sum = 0;
+   int length, size, from, to, weight;
+
+   reader.nextLine(line, length);
+   TextReader::parseInt(line, line + length, size);
+   for (int vertex = 1; vertex <= size; vertex++)
+      reader.nextLine(line, length);
+   while (reader.nextLine(line, length)) {
+      end = line + length;
+      if (!TextReader::parseInt(line, end, from) || from == 0) break;
+      TextReader::parseInt(line, end, to);
+      TextReader::parseInt(line, end, weight);
+      sum += from + to + weight;
+   }
+   reader.finish();
+   return sum + size;
+}
+
+
+//-------------------------- main -------------------------------------------
+// Makes the graph, parses it both ways and prints the best times.
+// Preconditions:   The current directory is writable.
+// Postconditions:  The times are printed, or an error is printed and 1 is
+//                  returned.
+int main(int argc, char *argv[]) {
+   int vertices = (argc > 1) ? atoi(argv[1]) : 200000;
+   int edges    = (argc > 2) ? atoi(argv[2]) : 2000000;
+   int runs     = (argc > 3) ? atoi(argv[3]) : 3;
+   if (argc > 4 || vertices < 1 || edges < 1 || runs < 1) {
+      cerr << "Usage: " << argv[0] << " [vertices [edges [runs]]]" << endl;
+      return 1;
+   }
+
+   GraphGenerator generator(1);
+   generator.makeRandom(vertices, edges, 1000);
+   if (!generator.write(INPUT_FILE)) {
+      cerr << "File could not be written." << endl;
+      return 1;
+   }
+   double megabytes = file_megabytes(INPUT_FILE);
+
+   double stream_best = 0, reader_best = 0, build_best = 0;
+   long long stream_sum = 0, reader_sum = 0;
+   bool built = true;
+
+   for (int run = 0; run < runs; run++) {
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      stream_sum = stream_parse(INPUT_FILE);
+      double elapsed = seconds_since(start);
+      if (run == 0 || elapsed < stream_best) stream_best = elapsed;
+
+      start = chrono::steady_clock::now();
+      reader_sum = reader_parse(INPUT_FILE);
+      elapsed = seconds_since(start);
+      if (run == 0 || elapsed < reader_best) reader_best = elapsed;
+
+      // The Graph is destroyed outside the timed part.
+      Graph G;
+      G.setLazy(true);
+      ifstream infile(INPUT_FILE);
+      start = chrono::steady_clock::now();
+      built = G.buildGraph(infile) && built;
+      elapsed = seconds_since(start);
+      if (run == 0 || elapsed < build_best) build_best = elapsed;
+   }
+   remove(INPUT_FILE);
+
+   cout << vertices << " vertices, " << edges << " edges, " << fixed
+        << setprecision(1) << megabytes << " MB" << endl;
+   print_rate("ifstream >> parse", stream_best, megabytes);
+   cout << endl;
+   print_rate("TextReader parse", reader_best, megabytes);
+   cout << "  " << setprecision(2) << stream_best / reader_best
+        << "x faster" << endl;
+   print_rate("lazy buildGraph", build_best, megabytes);
+   cout << endl;
+
+   if (stream_sum != reader_sum || !built) {
+      cerr << "The parses did not read the same graph." << endl;
+      return 1;
+   }
+   return 0;
+}
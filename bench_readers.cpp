@@ -0,0 +1,156 @@
+//---------------------------------------------------------------------------
+// BENCH_READERS.CPP
+// Measures the queries per second of ConcurrentGraph readers, with no
+// writer and then with one writer publishing a stream of edge updates.
+//---------------------------------------------------------------------------
+// Usage: bench_readers [readers [seconds [rows]]]
+//
+// The graph is a square grid of rows x rows vertices, like a road
+// network, written to bench_readers.txt in the current directory and
+// removed once it is read. Each reader thread has its own Reader and
+// runs Reader::findPath between random vertices for the given seconds.
+// The writer changes the weights of UPDATES_PER_VERSION random edges,
+// publishes them, and pauses PUBLISH_PAUSE_MS before the next batch.
+//
+// Assumptions:
+//   -- the numbers are positive, and there are at most
+//      ConcurrentGraph::MAX_READERS readers.
+//---------------------------------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <stdlib.h>
+#include <stdio.h>
+#include "ConcurrentGraph.h"
+#include "GraphGenerator.h"
+using namespace std;
+
+// The file the generated graph is written to.
+static const char *INPUT_FILE = "bench_readers.txt";
+
+// The edges the writer changes for each version it publishes, and how
+// long it waits between versions.
+static const int UPDATES_PER_VERSION = 100;
+static const int PUBLISH_PAUSE_MS = 10;
+
+
+//-------------------------- run_reader -------------------------------------
+// Runs findPath between random vertices until told to stop, and adds
+// the number of queries answered to the total.
+static void run_reader(ConcurrentGraph &graph, int vertices, unsigned seed,
+                       atomic<bool> &stop, atomic<long long> &total) {
+   ConcurrentGraph::Reader reader(graph);
+   GraphGenerator random(seed);
+   long long queries = 0;
+
+   while (!stop.load()) {
+      reader.findPath(random.nextInt(1, vertices), random.nextInt(1, vertices));
+      queries++;
+   }
+   total += queries;
+}
+
+
+//-------------------------- run_writer -------------------------------------
+// Changes the weights of random edges and publishes them in batches
+// until told to stop, and counts the versions published.
+static void run_writer(ConcurrentGraph &graph,
+                       const vector<GraphGenerator::Edge> &edges,
+                       atomic<bool> &stop, int &versions) {
+   GraphGenerator random(2);
+
+   versions = 0;
+   while (!stop.load()) {
+      for (int update = 0; update < UPDATES_PER_VERSION; update++) {
+         const GraphGenerator::Edge &edge =
+            edges [random.nextInt(0, (int) edges.size() - 1)];
+         graph.insertEdge(edge.from, edge.to, random.nextInt(1, 100));
+      }
+      graph.publish();
+      versions++;
+      this_thread::sleep_for(chrono::milliseconds(PUBLISH_PAUSE_MS));
+   }
+}
+
+
+//-------------------------- measure ----------------------------------------
+// Runs the readers, and the writer if the bool is true, for the given
+// seconds. Returns the queries per second of all the readers together.
+static double measure(ConcurrentGraph &graph, int readers, int seconds,
+                      int vertices, const vector<GraphGenerator::Edge> &edges,
+                      bool writing, int &versions) {
+   atomic<bool> stop(false);
+   atomic<long long> total(0);
+   vector<thread> threads;
+
+   versions = 0;
+   for (int reader = 0; reader < readers; reader++)
+      threads.push_back(thread(run_reader, ref(graph), vertices,
+                               (unsigned) (reader + 10), ref(stop),
+                               ref(total)));
+   if (writing)
+      threads.push_back(thread(run_writer, ref(graph), cref(edges),
+                               ref(stop), ref(versions)));
+
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   this_thread::sleep_for(chrono::seconds(seconds));
+   stop.store(true);
+   for (int i = 0; i < (int) threads.size(); i++) threads [i].join();
+   double elapsed =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+   return total.load() / elapsed;
+}
+
+
+//-------------------------- main -------------------------------------------
+// Builds the graph and prints the readers' queries per second without
+// and with the writer.
+// Preconditions:   The current directory is writable.
+// Postconditions:  The rates are printed, or an error is printed and 1 is
+//                  returned.
+int main(int argc, char *argv[]) {
+   int readers = (argc > 1) ? atoi(argv[1]) : 4;
+   int seconds = (argc > 2) ? atoi(argv[2]) : 3;
+   int rows    = (argc > 3) ? atoi(argv[3]) : 200;
+   if (argc > 4 || readers < 1 || readers > ConcurrentGraph::MAX_READERS ||
+       seconds < 1 || rows < 2) {
+      cerr << "Usage: " << argv[0] << " [readers [seconds [rows]]]" << endl;
+      return 1;
+   }
+
+   GraphGenerator generator(1);
+   generator.makeGrid(rows, rows, 100, false);
+   if (!generator.write(INPUT_FILE)) {
+      cerr << "File could not be written." << endl;
+      return 1;
+   }
+
+   ConcurrentGraph graph;
+   ifstream infile(INPUT_FILE);
+   bool built = graph.buildGraph(infile);
+   infile.close();
+   remove(INPUT_FILE);
+   if (!built) {
+      cerr << "The graph could not be built." << endl;
+      return 1;
+   }
+
+   int versions;
+   double idle = measure(graph, readers, seconds, generator.getSize(),
+                         generator.getEdges(), false, versions);
+   double busy = measure(graph, readers, seconds, generator.getSize(),
+                         generator.getEdges(), true, versions);
+
+   cout << generator.getSize() << " vertices, " << readers << " readers, "
+        << seconds << " s each" << endl;
+   cout << fixed << setprecision(0);
+   cout << "no writer      " << setw(10) << idle << " queries/s" << endl;
+   cout << "with writer    " << setw(10) << busy << " queries/s, "
+        << versions << " versions published" << endl;
+   return 0;
+}
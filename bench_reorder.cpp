@@ -0,0 +1,119 @@
+//---------------------------------------------------------------------------
+// BENCH_REORDER.CPP
+// Times single-source queries on a large sparse graph as read, and after
+// Graph::reorder in each of its orders.
+//---------------------------------------------------------------------------
+// Usage: bench_reorder [rows [sources]]
+//
+// The graph is a square grid of rows x rows vertices, like a road
+// network, with its vertices numbered in a random order so neighbours
+// are far apart in memory until the graph is reordered. It is written to
+// bench_reorder.txt in the current directory and removed at the end.
+// Each query computes the whole row of the table from one source, in
+// lazy mode, from the same random sources for every order, and the
+// distances are checked against the ones found as read.
+//
+// Cache misses can be counted by running under a profiler, for example:
+//   perf stat -e cache-references,cache-misses bench_reorder 500 20
+//
+// Assumptions:
+//   -- the numbers are positive.
+//---------------------------------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <stdlib.h>
+#include <stdio.h>
+#include "Graph.h"
+#include "GraphGenerator.h"
+using namespace std;
+
+// The file the generated graph is written to.
+static const char *INPUT_FILE = "bench_reorder.txt";
+
+
+//-------------------------- seconds_since ----------------------------------
+// Returns the seconds from the given time to now.
+static double seconds_since(chrono::steady_clock::time_point start) {
+   return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+
+//-------------------------- run_queries ------------------------------------
+// Builds the graph from the file, reorders it if the bool is true, and
+// computes the row of each source. Prints the times under the label and
+// returns the sum of the distances from each source to every vertex.
+static long long run_queries(const char *label, bool reordered,
+                             Graph::Ordering ordering,
+                             const vector<int> &sources) {
+   Graph G;
+   G.setLazy(true);
+   ifstream infile(INPUT_FILE);
+   G.buildGraph(infile);
+
+   double ordered = 0;
+   if (reordered) {
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      G.reorder(ordering);
+      ordered = seconds_since(start);
+   }
+
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   for (int i = 0; i < (int) sources.size(); i++)
+      G.getDistance(sources [i], sources [i]);
+   double queried = seconds_since(start);
+
+   long long sum = 0;
+   for (int i = 0; i < (int) sources.size(); i++)
+      for (int vertex = 1; vertex <= G.getSize(); vertex++)
+         sum += G.getDistance(sources [i], vertex);
+
+   cout << left << setw(14) << label << right << fixed << setprecision(3)
+        << setw(10) << queried * 1000 / sources.size() << " ms per query";
+   if (reordered) cout << "  (reorder " << ordered * 1000 << " ms)";
+   cout << endl;
+   return sum;
+}
+
+
+//-------------------------- main -------------------------------------------
+// Makes the graph and prints the query times for every order.
+// Preconditions:   The current directory is writable.
+// Postconditions:  The times are printed, or an error is printed and 1 is
+//                  returned.
+int main(int argc, char *argv[]) {
+   int rows  = (argc > 1) ? atoi(argv[1]) : 500;
+   int count = (argc > 2) ? atoi(argv[2]) : 20;
+   if (argc > 3 || rows < 2 || count < 1) {
+      cerr << "Usage: " << argv[0] << " [rows [sources]]" << endl;
+      return 1;
+   }
+
+   GraphGenerator generator(1);
+   generator.makeGrid(rows, rows, 100, true);
+   if (!generator.write(INPUT_FILE)) {
+      cerr << "File could not be written." << endl;
+      return 1;
+   }
+
+   vector<int> sources;
+   for (int i = 0; i < count; i++)
+      sources.push_back(generator.nextInt(1, generator.getSize()));
+
+   cout << generator.getSize() << " vertices, "
+        << generator.getEdges().size() << " edges, shuffled" << endl;
+   long long as_read = run_queries("as read", false, Graph::BFS_ORDER, sources);
+   long long bfs = run_queries("BFS_ORDER", true, Graph::BFS_ORDER, sources);
+   long long rcm = run_queries("RCM_ORDER", true, Graph::RCM_ORDER, sources);
+   long long degree = run_queries("DEGREE_ORDER", true, Graph::DEGREE_ORDER,
+                                  sources);
+   remove(INPUT_FILE);
+
+   if (bfs != as_read || rcm != as_read || degree != as_read) {
+      cerr << "A reordered graph found different distances." << endl;
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,245 @@
+//---------------------------------------------------------------------------
+// BENCH_TABLE.CPP
+// Times the O(V^2) Dijkstra kernel with a row of the table laid out as
+// the array of structs Graph used to have against the per-field arrays
+// it has now, on a random graph.
+//---------------------------------------------------------------------------
+// Usage: bench_table [vertices [edges [sources [aos | soa | both]]]]
+//
+// Both kernels walk the same CSR arrays, built here from the generated
+// edges, and scan for the next vertex one entry at a time, so only the
+// layout differs:
+//   aos  - one struct of visited flag, distance (-1 for none) and
+//          previous vertex per vertex, the old Table.
+//   soa  - a distance array with an INFINITE sentinel, a bit per vertex
+//          for visited, a previous vertex array, and a key array that
+//          the scan reads alone, the way Graph's Row does.
+// The graph itself is also timed from the same sources with the
+// LINEAR_SCAN strategy, which adds the vectorized MinimumScan. The
+// graph is written to bench_table.txt in the current directory and
+// removed once it is read.
+//
+// Cache misses can be counted by running one layout at a time under a
+// profiler, for example:
+//   perf stat -e cache-references,cache-misses bench_table 3000 60000 200 aos
+//
+// Assumptions:
+//   -- the counts are positive.
+//---------------------------------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <limits.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "Graph.h"
+#include "GraphGenerator.h"
+using namespace std;
+
+// The file the generated graph is written to.
+static const char *INPUT_FILE = "bench_table.txt";
+
+// The graph as CSR arrays: the edges of vertex v are at offsets [v] up
+// to offsets [v + 1] of targets and weights.
+struct Csr {
+   int size;
+   vector<int> offsets;
+   vector<int> targets;
+   vector<int> weights;
+};
+
+// An entry of a row in the old layout.
+struct Table {
+   bool isVisited;
+   int distance;
+   int prev_vertex;
+};
+
+
+//-------------------------- seconds_since ----------------------------------
+// Returns the seconds from the given time to now.
+static double seconds_since(chrono::steady_clock::time_point start) {
+   return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+
+//-------------------------- make_csr ---------------------------------------
+// Builds the CSR arrays of the generated graph.
+static void make_csr(const GraphGenerator &generator, Csr &csr) {
+   const vector<GraphGenerator::Edge> &edges = generator.getEdges();
+   vector<int> next;
+
+   csr.size = generator.getSize();
+   csr.offsets.assign(csr.size + 2, 0);
+   for (int i = 0; i < (int) edges.size(); i++) csr.offsets [edges [i].from + 1]++;
+   for (int v = 1; v <= csr.size + 1; v++) csr.offsets [v] += csr.offsets [v - 1];
+
+   next.assign(csr.offsets.begin(), csr.offsets.end());
+   csr.targets.resize(edges.size());
+   csr.weights.resize(edges.size());
+   for (int i = 0; i < (int) edges.size(); i++) {
+      int at = next [edges [i].from]++;
+      csr.targets [at] = edges [i].to;
+      csr.weights [at] = edges [i].weight;
+   }
+}
+
+
+//-------------------------- run_aos ----------------------------------------
+// Runs Dijkstra's algorithm from the source with the old row layout, the
+// way Graph did before its Row. Returns the sum of the distances found.
+static long long run_aos(const Csr &csr, int source, vector<Table> &row) {
+   for (int v = 1; v <= csr.size; v++) {
+      row [v].isVisited   = false;
+      row [v].distance    = -1;
+      row [v].prev_vertex = 0;
+   }
+   row [source].distance    = 0;
+   row [source].prev_vertex = source;
+
+   for (;;) {
+      int vertex = 0, best = INT_MAX;
+      for (int v = 1; v <= csr.size; v++) {
+         if (!row [v].isVisited && row [v].distance != -1 &&
+             row [v].distance < best) {
+            best = row [v].distance;
+            vertex = v;
+         }
+      }
+      if (vertex == 0) break;
+      row [vertex].isVisited = true;
+
+      for (int edge = csr.offsets [vertex]; edge < csr.offsets [vertex + 1]; edge++) {
+         int adjacent = csr.targets [edge];
+         if (row [adjacent].isVisited) continue;
+         int distance = row [vertex].distance + csr.weights [edge];
+         if (row [adjacent].distance == -1 || distance < row [adjacent].distance) {
+            row [adjacent].distance    = distance;
+            row [adjacent].prev_vertex = vertex;
+         }
+      }
+   }
+
+   long long sum = 0;
+   for (int v = 1; v <= csr.size; v++)
+      if (row [v].distance != -1) sum += row [v].distance;
+   return sum;
+}
+
+
+//-------------------------- run_soa ----------------------------------------
+// Runs Dijkstra's algorithm from the source with the per-field layout,
+// the way Graph's linear kernel does, but with a scalar scan. Returns the
+// sum of the distances found.
+static long long run_soa(const Csr &csr, int source, vector<int> &distances,
+                         vector<int> &previous, vector<bool> &visited,
+                         vector<int> &keys) {
+   distances.assign(csr.size + 1, INT_MAX);
+   previous.assign(csr.size + 1, 0);
+   visited.assign(csr.size + 1, false);
+   keys.assign(csr.size + 1, INT_MAX);
+   distances [source] = 0;
+   previous [source]  = source;
+   keys [source]      = 0;
+
+   for (;;) {
+      int vertex = 1;
+      for (int v = 2; v <= csr.size; v++)
+         if (keys [v] < keys [vertex]) vertex = v;
+      if (keys [vertex] == INT_MAX) break;
+      visited [vertex] = true;
+      keys [vertex] = INT_MAX;
+
+      for (int edge = csr.offsets [vertex]; edge < csr.offsets [vertex + 1]; edge++) {
+         int adjacent = csr.targets [edge];
+         int distance = distances [vertex] + csr.weights [edge];
+         if (distance < distances [adjacent]) {
+            distances [adjacent] = distance;
+            keys [adjacent]      = distance;
+            previous [adjacent]  = vertex;
+         }
+      }
+   }
+
+   long long sum = 0;
+   for (int v = 1; v <= csr.size; v++)
+      if (distances [v] != INT_MAX) sum += distances [v];
+   return sum;
+}
+
+
+//-------------------------- main -------------------------------------------
+// Makes the graph and prints the time per source of each layout.
+// Preconditions:   The current directory is writable.
+// Postconditions:  The times are printed, or an error is printed and 1 is
+//                  returned.
+int main(int argc, char *argv[]) {
+   int vertices = (argc > 1) ? atoi(argv[1]) : 3000;
+   int edges    = (argc > 2) ? atoi(argv[2]) : 60000;
+   int sources  = (argc > 3) ? atoi(argv[3]) : 200;
+   const char *layout = (argc > 4) ? argv[4] : "both";
+   bool aos = strcmp(layout, "aos") == 0 || strcmp(layout, "both") == 0;
+   bool soa = strcmp(layout, "soa") == 0 || strcmp(layout, "both") == 0;
+   if (argc > 5 || vertices < 1 || edges < 1 || sources < 1 || (!aos && !soa)) {
+      cerr << "Usage: " << argv[0]
+           << " [vertices [edges [sources [aos | soa | both]]]]" << endl;
+      return 1;
+   }
+   if (sources > vertices) sources = vertices;
+
+   GraphGenerator generator(1);
+   generator.makeRandom(vertices, edges, 100);
+   Csr csr;
+   make_csr(generator, csr);
+
+   cout << vertices << " vertices, " << edges << " edges, " << sources
+        << " sources" << endl;
+   cout << fixed << setprecision(3);
+
+   long long aos_sum = 0, soa_sum = 0;
+   if (aos) {
+      vector<Table> row(vertices + 1);
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      for (int source = 1; source <= sources; source++)
+         aos_sum += run_aos(csr, source, row);
+      cout << "array of structs   " << setw(9)
+           << seconds_since(start) * 1000 / sources << " ms per source" << endl;
+   }
+   if (soa) {
+      vector<int> distances, previous, keys;
+      vector<bool> visited;
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      for (int source = 1; source <= sources; source++)
+         soa_sum += run_soa(csr, source, distances, previous, visited, keys);
+      cout << "per-field arrays   " << setw(9)
+           << seconds_since(start) * 1000 / sources << " ms per source" << endl;
+   }
+   if (aos && soa && aos_sum != soa_sum) {
+      cerr << "The layouts found different distances." << endl;
+      return 1;
+   }
+   if (!aos || !soa) return 0;
+
+   if (!generator.write(INPUT_FILE)) {
+      cerr << "File could not be written." << endl;
+      return 1;
+   }
+   Graph G;
+   G.setLazy(true);
+   G.setStrategy(Graph::LINEAR_SCAN);
+   ifstream infile(INPUT_FILE);
+   G.buildGraph(infile);
+   infile.close();
+   remove(INPUT_FILE);
+
+   // Computing a source's row is what getDistance times here.
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   for (int source = 1; source <= sources; source++)
+      G.getDistance(source, source);
+   cout << "Graph LINEAR_SCAN  " << setw(9)
+        << seconds_since(start) * 1000 / sources << " ms per source" << endl;
+   return 0;
+}
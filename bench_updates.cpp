@@ -0,0 +1,145 @@
+//---------------------------------------------------------------------------
+// BENCH_UPDATES.CPP
+// Times the incremental repair of the table after an edge update against
+// recomputing the whole table, on a random graph.
+//---------------------------------------------------------------------------
+// Usage: bench_updates [vertices [edges [updates]]]
+//
+// The graph is written to bench_updates.txt in the current directory,
+// read in eager mode, and removed at the end. The updates take turns
+// inserting a new random edge, removing a random edge, and changing the
+// weight of a random edge. Each one is timed as insertEdge or removeEdge
+// repairs the table, then findShortestPath recomputes the whole table
+// for the same graph and is timed too. One row of the repaired table is
+// compared with the recomputed one, so a wrong repair is reported.
+//
+// Assumptions:
+//   -- the counts are positive, and the table of vertices^2 entries fits
+//      in memory.
+//---------------------------------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <stdlib.h>
+#include <stdio.h>
+#include "Graph.h"
+#include "GraphGenerator.h"
+using namespace std;
+
+// The file the generated graph is written to.
+static const char *INPUT_FILE = "bench_updates.txt";
+
+// The kinds of update, in the order they take turns.
+enum UpdateKind { INSERT, REMOVE, REWEIGHT, KINDS };
+static const char *KIND_NAMES [KINDS] = { "insert", "remove", "reweight" };
+
+
+//-------------------------- seconds_since ----------------------------------
+// Returns the seconds from the given time to now.
+static double seconds_since(chrono::steady_clock::time_point start) {
+   return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+
+//-------------------------- main -------------------------------------------
+// Makes the graph, applies the updates and prints the time each kind of
+// update took repaired and recomputed.
+// Preconditions:   The current directory is writable.
+// Postconditions:  The times are printed, or an error is printed and 1 is
+//                  returned.
+int main(int argc, char *argv[]) {
+   int vertices = (argc > 1) ? atoi(argv[1]) : 1000;
+   int edges    = (argc > 2) ? atoi(argv[2]) : 8000;
+   int updates  = (argc > 3) ? atoi(argv[3]) : 60;
+   if (argc > 4 || vertices < 2 || edges < 1 || updates < 1) {
+      cerr << "Usage: " << argv[0] << " [vertices [edges [updates]]]" << endl;
+      return 1;
+   }
+
+   GraphGenerator generator(1);
+   generator.makeRandom(vertices, edges, 100);
+   if (!generator.write(INPUT_FILE)) {
+      cerr << "File could not be written." << endl;
+      return 1;
+   }
+
+   ifstream infile(INPUT_FILE);
+   Graph G;
+   G.buildGraph(infile);
+   infile.close();
+   remove(INPUT_FILE);
+
+   // The edges that can be removed or reweighted.
+   vector<GraphGenerator::Edge> live = generator.getEdges();
+
+   double repaired [KINDS] = { 0, 0, 0 };
+   double recomputed [KINDS] = { 0, 0, 0 };
+   int count [KINDS] = { 0, 0, 0 };
+   int mismatches = 0;
+   vector<int> row(vertices + 1);
+
+   for (int update = 0; update < updates; update++) {
+      UpdateKind kind = (UpdateKind) (update % KINDS);
+      GraphGenerator::Edge edge;
+      bool changed;
+
+      if (kind != INSERT && live.empty()) continue;
+      int pick = (kind == INSERT) ? 0 :
+                 generator.nextInt(0, (int) live.size() - 1);
+
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      if (kind == INSERT) {
+         edge.from   = generator.nextInt(1, vertices);
+         edge.to     = generator.nextInt(1, vertices);
+         edge.weight = generator.nextInt(1, 100);
+         changed = G.insertEdge(edge.from, edge.to, edge.weight);
+         if (changed) live.push_back(edge);
+      } else if (kind == REMOVE) {
+         changed = G.removeEdge(live [pick].from, live [pick].to);
+         live [pick] = live.back();
+         live.pop_back();
+      } else {
+         live [pick].weight = generator.nextInt(1, 100);
+         changed = G.insertEdge(live [pick].from, live [pick].to,
+                                live [pick].weight);
+      }
+      double elapsed = seconds_since(start);
+
+      // A duplicate of an edge already removed changes nothing.
+      if (!changed) continue;
+      repaired [kind] += elapsed;
+      count [kind]++;
+
+      int source = generator.nextInt(1, vertices);
+      for (int target = 1; target <= vertices; target++)
+         row [target] = G.getDistance(source, target);
+
+      start = chrono::steady_clock::now();
+      G.findShortestPath();
+      recomputed [kind] += seconds_since(start);
+
+      for (int target = 1; target <= vertices; target++)
+         if (row [target] != G.getDistance(source, target)) mismatches++;
+   }
+
+   cout << vertices << " vertices, " << edges << " edges" << endl;
+   cout << "update      count   repair ms   recompute ms   speedup" << endl;
+   for (int kind = 0; kind < KINDS; kind++) {
+      if (count [kind] == 0) continue;
+      cout << left << setw(10) << KIND_NAMES [kind] << right
+           << setw(7) << count [kind] << fixed << setprecision(3)
+           << setw(12) << repaired [kind] * 1000 / count [kind]
+           << setw(15) << recomputed [kind] * 1000 / count [kind]
+           << setprecision(1) << setw(9)
+           << recomputed [kind] / (repaired [kind] > 0 ? repaired [kind] : 1e-9)
+           << "x" << endl;
+   }
+   if (mismatches != 0) {
+      cerr << mismatches << " distances differ from the recomputed table."
+           << endl;
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,67 @@
+//---------------------------------------------------------------------------
+// CONVERT.CPP
+// Converts a graph from the HW3.txt text format to the binary format
+// read by Graph::openBinary.
+//---------------------------------------------------------------------------
+// Usage: convert <text file> <binary file> [bfs | rcm | degree]
+//
+// The optional ordering renumbers the vertices internally before the
+// graph is written, see Graph::reorder, so the binary file opens
+// with its vertices stored in that order.
+//
+// Assumptions:
+//   -- the text file is formatted as described in the specifications,
+//      only the first graph in it is converted.
+//---------------------------------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <string.h>
+#include "Graph.h"
+using namespace std;
+
+
+//-------------------------- main -------------------------------------------
+// Reads the graph from the text file named by the first argument and
+// writes it to the binary file named by the second, reordered if a
+// third argument names an ordering.
+// Preconditions:   The text file exists and is properly formatted.
+// Postconditions:  The binary file holds the graph, or an error is printed
+//                  and 1 is returned.
+int main(int argc, char *argv[]) {
+   Graph::Ordering ordering = Graph::BFS_ORDER;
+   if (argc == 4) {
+      if (strcmp(argv[3], "bfs") == 0) ordering = Graph::BFS_ORDER;
+      else if (strcmp(argv[3], "rcm") == 0) ordering = Graph::RCM_ORDER;
+      else if (strcmp(argv[3], "degree") == 0) ordering = Graph::DEGREE_ORDER;
+      else argc = 0;
+   }
+   if (argc != 3 && argc != 4) {
+      cerr << "Usage: " << argv[0] 
+           << " <text file> <binary file> [bfs | rcm | degree]" << endl;
+      return 1;
+   }
+
+   ifstream infile(argv[1]);
+   if (!infile) {
+      cerr << "File could not be opened." << endl;
+      return 1;
+   }
+
+   // No shortest paths are needed to convert the graph.
+   Graph G;
+   G.setLazy(true);
+   if (!G.buildGraph(infile)) {
+      if (G.errorLine() != 0)
+         cerr << "Line " << G.errorLine() << ": " << G.errorMessage() << endl;
+      else
+         cerr << "The file holds no graph." << endl;
+      return 1;
+   }
+   if (argc == 4) G.reorder(ordering);
+
+   if (!G.saveBinary(argv[2])) {
+      cerr << "File could not be written." << endl;
+      return 1;
+   }
+   return 0;
+}
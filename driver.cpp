@@ -34,7 +34,8 @@ int main() {
    //for each graph, find the shortest path from every vertex to all other vertices
 //   for(;;){
       Graph G;
-      G.buildGraph(infile1);
+      if (!G.buildGraph(infile1) && G.errorLine() != 0)
+         cerr << "Line " << G.errorLine() << ": " << G.errorMessage() << endl;
       if (infile1.eof()) 
  //       break;
       G.findShortestPath();        